@@ -0,0 +1,54 @@
+# Packs a word list into a constexpr header so the binaries start without any file I/O.
+# Usage: cmake -DINPUT=<word list> -DOUTPUT=<header> -P EmbedDictionary.cmake
+# Words may be separated by any whitespace, case does not matter, duplicates are removed.
+
+if(NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "EmbedDictionary.cmake needs -DINPUT=<word list> and -DOUTPUT=<header>")
+endif()
+
+file(READ "${INPUT}" content)
+string(TOLOWER "${content}" content)
+string(REGEX MATCHALL "[^ \t\r\n]+" words "${content}")
+list(REMOVE_DUPLICATES words)
+# Alphabetical order == numeric order of the packed letters (first letter in the highest bits)
+list(SORT words)
+
+set(alphabet "abcdefghijklmnopqrstuvwxyz")
+set(entries "")
+set(count 0)
+foreach(word IN LISTS words)
+    if(NOT word MATCHES "^[a-z][a-z][a-z][a-z][a-z]$")
+        message(FATAL_ERROR "Word list ${INPUT} contains '${word}', which is not a five-letter word")
+    endif()
+    set(packed 0)
+    foreach(pos RANGE 0 4)
+        string(SUBSTRING "${word}" ${pos} 1 ch)
+        string(FIND "${alphabet}" "${ch}" letter)
+        math(EXPR packed "(${packed} << 5) | ${letter}" OUTPUT_FORMAT HEXADECIMAL)
+    endforeach()
+    string(APPEND entries "        makeWord(${packed}u), // ${word}\n")
+    math(EXPR count "${count} + 1")
+endforeach()
+
+if(count EQUAL 0)
+    message(FATAL_ERROR "Word list ${INPUT} is empty")
+endif()
+
+get_filename_component(input_name "${INPUT}" NAME)
+set(header "// Generated by cmake/EmbedDictionary.cmake from ${input_name} - do not edit.
+#pragma once
+#include <array>
+#include \"Word.h\"
+
+/// Packed, sorted, de-duplicated dictionary compiled into the binary.
+constexpr std::array<Word, ${count}> EMBEDDED_WORDS = {{
+${entries}}};
+")
+
+# Only touch the header if it changed, so unrelated builds do not recompile the library
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" old_header)
+endif()
+if(NOT "${old_header}" STREQUAL "${header}")
+    file(WRITE "${OUTPUT}" "${header}")
+endif()
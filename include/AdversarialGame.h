@@ -0,0 +1,40 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "FeedbackStrategy.h"
+#include "WordTable.h"
+
+/**
+ * @brief Absurdle-style game: there is no fixed secret. Every guess is answered with the
+ * feedback of the largest group of words that are still consistent, so the secret is only
+ * pinned down when the solver leaves no other choice.
+ */
+class AdversarialGame {
+public:
+  enum class Policy {
+    LargestBucket, // largest bucket, ties by lowest pattern code
+    MostDamaging   // largest bucket, ties by fewest greens then fewest yellows; a win only if forced
+  };
+
+  explicit AdversarialGame(std::shared_ptr<const WordTable> words, Policy policy = Policy::LargestBucket);
+
+  /**
+   * @brief Answers a guess with the most damaging feedback and keeps only that bucket.
+   * @throws NotAFiveLetterWordException / NotAValidWordException for malformed guesses.
+   * @throws GuessLimitReachedException if all tries are used.
+   */
+  std::vector<Feedback> guess(const std::string& word);
+  Pattern respond(Word guess);
+
+  [[nodiscard]] int getTries() const { return tries; }
+  [[nodiscard]] int getMaxTries() const { return maxTries; }
+  [[nodiscard]] const std::vector<int>& getCandidates() const { return candidates; }
+  int maxTries = 6;
+
+private:
+  std::shared_ptr<const WordTable> words;
+  Policy policy;
+  std::vector<int> candidates;
+  int tries = 0;
+};
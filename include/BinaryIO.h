@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Fixed-width little endian fields for the result and checkpoint files,
+ * independent of the host byte order.
+ */
+inline void putLittleEndian(std::string& out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+/**
+ * @brief Reads the fields written by putLittleEndian and throws if the data runs out.
+ */
+class LittleEndianReader {
+public:
+  LittleEndianReader(const std::string& data, const std::string& file) : data(data), file(file) {}
+
+  std::uint64_t get(int bytes) {
+    if (pos + bytes > data.size()) {
+      throw std::runtime_error("[ERROR] The file '" + file + "' is truncated.");
+    }
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+      value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[pos++])) << (8 * i);
+    }
+    return value;
+  }
+  [[nodiscard]] bool done() const { return pos == data.size(); }
+
+  /**
+   * @brief Reads an element count and checks it against the bytes left, before anything is allocated.
+   * @param minBytes Smallest encoded size of one element.
+   */
+  std::size_t getCount(int bytes, std::size_t minBytes) {
+    const std::uint64_t count = get(bytes);
+    if (minBytes > 0 && count > (data.size() - pos) / minBytes) {
+      throw std::runtime_error("[ERROR] The file '" + file + "' is truncated.");
+    }
+    return static_cast<std::size_t>(count);
+  }
+
+private:
+  const std::string& data;
+  const std::string& file;
+  std::size_t pos = 0;
+};
+
+/**
+ * @brief Writes data to file.tmp, flushes it to disk and renames it over file,
+ * so readers only ever see the old or the new complete file.
+ * @throws std::runtime_error if the file can not be written.
+ */
+void writeFileAtomically(const std::string& file, const std::string& data);
@@ -0,0 +1,94 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FeedbackStrategy.h"
+#include "Simulation.h"
+#include "WordleSolver.h"
+#include "WordTable.h"
+
+/**
+ * @brief Games of a lockstep run that share one guess/feedback history, i.e. one solver state.
+ * Members are positions in the secrets vector.
+ */
+struct LockstepState {
+  std::vector<int> path;
+  std::vector<Pattern> feedback;
+  std::vector<int> members;
+  std::shared_ptr<const WordleSolver> solver; // state after the history; not saved, rebuilt by replay if null
+};
+
+/**
+ * @brief Consistent picture of a lockstep run: finished games plus the solver states still to play.
+ */
+struct LockstepSnapshot {
+  std::uint64_t sequence = 0; // counts up with every checkpoint of a run
+  std::uint64_t runId = 0;    // Checkpoint::runId of the run
+  std::uint64_t states = 0;   // nextGuess calls so far
+  std::vector<int> finished;  // positions of the finished games
+  std::vector<GameRecord> records; // records[i] belongs to finished[i]
+  std::vector<int> histogram;      // histogram[t] = finished games with t tries, last entry = lost games
+  std::vector<LockstepState> pending;
+};
+
+/**
+ * @brief Versioned checkpoint file of a lockstep run.
+ *
+ * Little endian: magic "WRDC", version, then the snapshot. Each write replaces the file
+ * atomically, so a crash leaves the previous checkpoint intact.
+ */
+class Checkpoint {
+public:
+  static constexpr std::uint32_t VERSION = 1;
+
+  /**
+   * @brief Identifies a run by its word table, strategy and secrets.
+   */
+  static std::uint64_t runId(const WordTable& words, const std::vector<int>& secrets, const StrategyConfig& config);
+  static void write(const std::string& file, const LockstepSnapshot& snapshot);
+
+  /**
+   * @return False if the file does not exist.
+   * @throws std::runtime_error if the file exists but is no valid checkpoint.
+   */
+  static bool read(const std::string& file, LockstepSnapshot& snapshot);
+};
+
+/**
+ * @brief Writes checkpoints on a background thread, so workers only pay for taking the snapshot.
+ * A snapshot submitted while another is being written replaces any older one that is still waiting.
+ */
+class CheckpointWriter {
+public:
+  explicit CheckpointWriter(std::string file);
+  ~CheckpointWriter();
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  void submit(LockstepSnapshot snapshot);
+
+  /**
+   * @brief Writes the last submitted snapshot and stops the thread.
+   * @throws std::runtime_error if any checkpoint could not be written.
+   */
+  void finish();
+  [[nodiscard]] std::size_t getWritten() const;
+
+private:
+  void run();
+
+  std::string file;
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::unique_ptr<LockstepSnapshot> waiting;
+  bool stopping = false;
+  std::size_t written = 0;
+  std::exception_ptr error;
+  std::thread thread;
+};
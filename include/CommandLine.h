@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Parses a whole command line value as an unsigned number in [min, max].
+ * @return False if the value is empty, signed, has trailing characters or is out of range.
+ */
+inline bool parseNumber(const std::string& text, std::uint64_t min, std::uint64_t max, std::uint64_t& value) {
+  if (text.empty() || text[0] < '0' || text[0] > '9') return false;
+  std::size_t used = 0;
+  try {
+    value = std::stoull(text, &used);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return used == text.size() && value >= min && value <= max;
+}
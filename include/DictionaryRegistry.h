@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PatternTable.h"
+#include "WordTable.h"
+
+/**
+ * @brief One immutable version of a word list: the table with its letter indexes and,
+ * if the registry is configured for it, the pattern table built on top of it.
+ */
+struct Dictionary {
+  std::string name;
+  std::uint64_t version = 0; // unique within the registry, counts up with every load
+  std::shared_ptr<const WordTable> words;
+  std::shared_ptr<PatternTable> patterns; // null unless enablePatternTables() was called
+};
+
+/**
+ * @brief Process-wide registry that loads every word list once and hands out shared handles.
+ *
+ * Lists are keyed by name: a file path, or EMBEDDED for the dictionary compiled into the binary.
+ * A handle keeps its version alive, so games and solvers started on it finish on that snapshot
+ * even if reload() or publish() swaps in a new version meanwhile; later get() calls return the
+ * new one. An old version is freed when its last handle (or table/solver using it) goes away.
+ *
+ * All methods are thread safe. Lookups of loaded lists never wait for a list being loaded.
+ */
+class DictionaryRegistry {
+public:
+  using Handle = std::shared_ptr<const Dictionary>;
+  static constexpr const char* EMBEDDED = "<embedded>";
+
+  static DictionaryRegistry& instance();
+
+  /**
+   * @brief Current version of a list, loading it on first use.
+   * @throws WordListEmptyException if the file can not be read or has no valid words.
+   */
+  Handle get(const std::string& name);
+
+  /**
+   * @brief Reads the file again and swaps the new version in.
+   * @throws like get(); the current version stays in place on failure.
+   */
+  Handle reload(const std::string& name);
+
+  /**
+   * @brief Swaps in a table built elsewhere, e.g. a list received over the network.
+   * @throws WordListEmptyException if the table is empty.
+   */
+  Handle publish(const std::string& name, std::shared_ptr<const WordTable> words);
+
+  /**
+   * @return The current version, or null if the list was never loaded.
+   */
+  [[nodiscard]] Handle find(const std::string& name) const;
+  [[nodiscard]] std::vector<std::string> names() const;
+
+  /**
+   * @brief Builds a pattern table for every version loaded from now on.
+   * Every table creates its own scratch file from the prefix, so versions never share one.
+   */
+  void enablePatternTables(PatternTable::Options options);
+
+private:
+  Handle build(const std::string& name, std::shared_ptr<const WordTable> words);
+  static std::shared_ptr<const WordTable> load(const std::string& name);
+
+  mutable std::mutex mutex; // guards the fields below
+  std::unordered_map<std::string, Handle> current;
+  std::uint64_t lastVersion = 0;
+  std::optional<PatternTable::Options> patternOptions;
+
+  std::mutex loadMutex; // one load at a time, so a list is read once even if requested concurrently
+};
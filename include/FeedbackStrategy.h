@@ -1,12 +1,27 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include "Word.h"
 
 /**
  * @brief Enum representing feedback for each letter in a Wordle guess.
  */
 enum class Feedback { Correct, Present, Absent };
 
+/**
+ * @brief Feedback of a whole guess encoded base 3 (Absent = 0, Present = 1, Correct = 2),
+ * position i weighted with 3^i. 243 patterns fit into one byte.
+ */
+using Pattern = std::uint8_t;
+
+/// Number of distinct patterns for a five-letter word.
+constexpr int PATTERN_COUNT = 243;
+
+/// Pattern of a solved game (every letter Correct).
+constexpr Pattern ALL_CORRECT = 242;
+
 /**
  * @brief The FeedbackStrategy class provides the logic to calculate feedback for a guess.
  */
@@ -19,4 +34,28 @@ public:
      * @return A vector of Feedback enums for each letter.
      */
     static std::vector<Feedback> calculateFeedback(const std::string& guess, const std::string& solution) ;
+
+    /**
+     * @brief Calculates the feedback pattern of two packed words without any allocation.
+     * @param guess The guessed word.
+     * @param solution The solution word.
+     * @return The base-3 encoded pattern.
+     */
+    static Pattern calculatePattern(Word guess, Word solution);
+
+    /**
+     * @brief Encodes a feedback vector as Pattern.
+     * @throws std::runtime_error if the vector does not have five entries.
+     */
+    static Pattern toPattern(const std::vector<Feedback>& feedback);
+
+    /**
+     * @brief Decodes a Pattern into the per-letter feedback.
+     */
+    static std::array<Feedback, WORD_LENGTH> decodePattern(Pattern pattern);
+
+    /**
+     * @brief Decodes a Pattern into a feedback vector (I/O boundary).
+     */
+    static std::vector<Feedback> toFeedback(Pattern pattern);
 };
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "FeedbackStrategy.h"
+#include "Simulation.h"
+#include "WordTable.h"
+
+/**
+ * @brief One recorded game, parsed from a log line.
+ */
+struct LoggedGame {
+  std::uint64_t line = 0; // 1-based line number in the log
+  std::vector<int> guesses;
+  std::vector<Pattern> feedback;
+  std::string error; // set if the line could not be parsed
+};
+
+/**
+ * @brief Replay of one recorded move: the human guess next to the solver's choice for the same state.
+ */
+struct ReplayedMove {
+  enum class Status : std::uint8_t { Ok = 0, Unparsable = 1, Inconsistent = 2 };
+  std::uint64_t line = 0;
+  int move = 0;                 // 0-based
+  Status status = Status::Ok;
+  int guess = -1;               // human guess
+  int solverGuess = -1;         // what nextGuess() picks for the state before the move
+  Pattern feedback = 0;
+  int candidatesBefore = 0;
+  int candidatesAfter = 0;      // 0 if the feedback contradicts the history
+  double guessEntropy = 0.0;    // of the human guess over the candidates before the move
+  double solverEntropy = 0.0;   // of the solver's choice
+};
+
+/**
+ * @brief Streaming replay of recorded games through the solver.
+ *
+ * Log format: one game per line, moves separated by whitespace, each move "guess:feedback"
+ * with feedback digits 0 (absent), 1 (present), 2 (correct), e.g. "slate:00120 crony:22222".
+ * Empty lines and lines starting with '#' are skipped.
+ *
+ * A reader splits the log into batches of lines while reading it in fixed-size chunks, a pool of
+ * workers rebuilds every game with the solver's own filtering (applyFeedback) and scores each move,
+ * and a writer appends the batches to the output in input order. The number of batches in flight is
+ * capped, so memory stays bounded for any log size.
+ *
+ * Output (little endian): magic "WRDR", version, word count, dictionary hash, then per move
+ * line (u64), move (u8), status (u8), feedback (u8), candidates before and after (u32 each),
+ * entropies of the human guess and the solver's choice in millibits (u16 each),
+ * guess and solver guess as word indices (2 bytes below 65536 words, otherwise 4).
+ * A line that can not be parsed gives one record with status Unparsable.
+ */
+class LogReplay {
+public:
+  static constexpr std::uint32_t VERSION = 1;
+
+  struct Options {
+    unsigned threads = 0;         // 0 = hardware concurrency
+    std::size_t batchGames = 256; // games per batch
+    std::size_t chunkBytes = std::size_t{1} << 20; // read size of the log
+    std::size_t maxLineBytes = 4096; // longer lines are rejected without being buffered
+    std::size_t cachedStates = std::size_t{1} << 16; // solver choices kept for repeated histories
+  };
+  struct Stats {
+    std::uint64_t games = 0;
+    std::uint64_t moves = 0;
+    std::uint64_t unparsable = 0;   // lines that are no valid game
+    std::uint64_t inconsistent = 0; // games whose feedback contradicts their own history
+    std::uint64_t agreed = 0;       // moves where the human picked the solver's guess
+    std::uint64_t cacheHits = 0;    // moves whose solver choice came from the state cache
+    double seconds = 0.0;
+  };
+
+  /**
+   * @brief Solver choices by guess/feedback history, shared by the workers.
+   * Common openings repeat across millions of games, so most early states are solved once.
+   * Bounded: once full, new states are still computed but no longer stored.
+   */
+  class ChoiceCache {
+  public:
+    explicit ChoiceCache(std::size_t capacity) : capacity(capacity) {}
+    bool find(const std::string& history, int& guess, double& entropy) const;
+    void insert(const std::string& history, int guess, double entropy);
+
+  private:
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::pair<int, double>> choices;
+  };
+
+  /**
+   * @brief Replays every game of logFile and writes the per-move records to outFile.
+   * @throws std::runtime_error if a file can not be opened or written.
+   */
+  static Stats run(const std::string& logFile, const std::string& outFile,
+                   const std::shared_ptr<const WordTable>& words, const StrategyConfig& config, Options options);
+
+  static LoggedGame parseLine(const std::string& text, std::uint64_t line, const WordTable& words);
+  static std::vector<ReplayedMove> replayGame(const LoggedGame& game, const std::shared_ptr<const WordTable>& words,
+                                              const StrategyConfig& config, ChoiceCache* cache = nullptr,
+                                              std::uint64_t* cacheHits = nullptr);
+};
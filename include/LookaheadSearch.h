@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "FeedbackStrategy.h"
+#include "WordTable.h"
+
+/**
+ * @brief Two-ply lookahead for small candidate sets.
+ *
+ * Scores a guess by the probability of solving within the remaining tries:
+ *   f(S, t) = max_g 1/|S| * ( [g in S] + sum over feedback buckets B of |B| * f(B, t - 1) )
+ * The root ply tries every allowed guess, the second ply searches a smaller pool of
+ * follow-up guesses (memoized per sub-state), deeper plies use the lower bound min(1, t / |B|) of guessing candidates
+ * one by one. Root guesses run in parallel (small searches on fewer threads or inline) and are cut off as soon as even perfect play
+ * on their remaining buckets could not reach the best value found so far.
+ */
+class LookaheadSearch {
+public:
+  struct Result {
+    int guess = -1;                // index of the best guess
+    double solveProbability = 0.0; // f(S, t) of that guess
+    double quickSolveProbability = 0.0; // f(S, min(t, 3)), breaks ties towards short games
+    bool inCandidates = false;     // the guess can win right away
+    std::size_t buckets = 0;       // number of feedback buckets it splits S into
+  };
+
+  explicit LookaheadSearch(std::shared_ptr<const WordTable> words, unsigned threads = 0);
+
+  /**
+   * @brief Finds the guess with the highest probability of solving in time.
+   * Ties prefer a higher chance to solve within 3 tries, guesses that can win right away,
+   * then more buckets, then dictionary order.
+   * @param candidates Indices of the possible solutions (sorted).
+   * @param guesses Indices of the allowed guesses (sorted).
+   * @param followUps Indices of the guesses tried in the second ply, e.g. a prefilter shortlist.
+   * @param triesLeft Guesses left including this one.
+   */
+  Result search(const std::vector<int>& candidates, const std::vector<int>& guesses,
+                const std::vector<int>& followUps, int triesLeft);
+
+  void clearMemo();
+  [[nodiscard]] std::size_t memoSize() const;
+
+private:
+  // Pattern computations a search needs per thread before another thread pays off (~ a few ms)
+  static constexpr double MIN_WORK_PER_THREAD = 1 << 20;
+
+  struct StateHash {
+    std::size_t operator()(const std::vector<int>& state) const;
+  };
+
+  Result evaluateGuess(int guess, const std::vector<int>& candidates, const std::vector<int>& guesses,
+                       int triesLeft, double alpha);
+  double bucketValue(const std::vector<std::vector<int>>& buckets, bool inCandidates, std::size_t total,
+                     const std::vector<int>& guesses, int triesLeft, double alpha);
+  double solveProbability(const std::vector<int>& candidates, const std::vector<int>& guesses, int triesLeft);
+  static double leafEstimate(std::size_t size, int triesLeft);
+  static bool isBetter(const Result& a, const Result& b);
+
+  std::shared_ptr<const WordTable> words;
+  unsigned threads;
+  std::size_t poolHash = 0;
+  mutable std::mutex memoMutex;
+  // key: sorted candidate indices followed by the tries left
+  std::unordered_map<std::vector<int>, double, StateHash> memo;
+};
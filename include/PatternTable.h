@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "FeedbackStrategy.h"
+#include "WordTable.h"
+
+/**
+ * @brief Cache-blocked pattern computation for dictionaries where a full
+ * words x words pattern table does not fit into memory.
+ *
+ * - entropies() sweeps guesses x candidates in tiles: a tile of candidate words sized to
+ *   the L2 cache is reused for a block of guesses before moving on.
+ * - row() hands out pattern rows (one guess against every word) from an LRU cache whose
+ *   size is bounded by Options::memoryCap. Evicted rows can be spilled to a memory-mapped
+ *   scratch file, so a guess that is scored again is read back instead of recomputed.
+ *   The file is created with a unique name from the prefix and unlinked right away, so it
+ *   never replaces an existing file and disappears with the process.
+ *
+ * All methods are thread safe. Rows are shared pointers and stay valid after eviction.
+ */
+class PatternTable {
+public:
+  struct Options {
+    std::size_t memoryCap = std::size_t{64} << 20; // bytes of cached rows
+    std::size_t tileBytes = std::size_t{256} << 10; // candidate words per tile, ~ L2 size
+    std::string scratchFile;                        // path prefix of the spill file for evicted rows, empty = recompute
+  };
+  struct Stats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t spillReads = 0;
+    std::size_t spillWrites = 0;
+    std::size_t cachedRows = 0;
+  };
+  using Row = std::shared_ptr<const std::vector<Pattern>>;
+
+  PatternTable(std::shared_ptr<const WordTable> words, Options options);
+  ~PatternTable();
+  PatternTable(const PatternTable&) = delete;
+  PatternTable& operator=(const PatternTable&) = delete;
+
+  /**
+   * @brief Patterns of one guess against every word of the table (index = solution).
+   */
+  Row row(int guess);
+
+  /**
+   * @brief A full row only pays off if the candidates are a large part of the table,
+   * smaller sets are cheaper to score directly.
+   */
+  [[nodiscard]] bool rowsPayOff(std::size_t candidates) const { return candidates * ROW_MIN_SHARE >= words->size(); }
+
+  /**
+   * @brief Entropy of every guess over the candidates, computed tile by tile.
+   * @return entropies[i] belongs to guesses[i]; same values as WordleSolver::calculateEntropy.
+   */
+  std::vector<double> entropies(const std::vector<int>& guesses, const std::vector<int>& candidates) const;
+
+  [[nodiscard]] Stats getStats() const;
+  [[nodiscard]] std::size_t getCapacityRows() const { return capacityRows; }
+  [[nodiscard]] std::size_t getTileWords() const { return tileWords(); }
+
+private:
+  // Rows are used once the candidates are at least 1/ROW_MIN_SHARE of the table
+  static constexpr std::size_t ROW_MIN_SHARE = 4;
+
+  void insertRow(int guess, Row row);
+  bool readSpilled(int guess, std::vector<Pattern>& out);
+  void spill(int guess, const std::vector<Pattern>& row);
+  std::size_t tileWords() const;
+
+  std::shared_ptr<const WordTable> words;
+  Options options;
+  std::size_t capacityRows;
+
+  mutable std::mutex mutex;
+  std::list<int> lru; // most recently used first
+  std::unordered_map<int, std::pair<Row, std::list<int>::iterator>> cache;
+  Stats stats;
+
+  // Scratch file: words x words bytes, row i at offset i * words
+  int scratchFd = -1;
+  Pattern* scratch = nullptr;
+  std::size_t scratchSize = 0;
+  std::vector<bool> spilled;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+#include "WordTable.h"
+
+/**
+ * @brief Which games of a run one process plays: game g belongs to shard g % count.
+ */
+struct ShardSpec {
+  int index = 0;
+  int count = 1;
+
+  /**
+   * @brief Parses "i/N" with 0 <= i < N.
+   * @throws std::invalid_argument for anything else.
+   */
+  static ShardSpec parse(const std::string& text);
+  [[nodiscard]] bool owns(int game) const { return game % count == index; }
+};
+
+/**
+ * @brief Identifies the run a shard belongs to. Shards only merge if everything but the index matches.
+ */
+struct ShardHeader {
+  ShardSpec shard;
+  std::uint64_t seed = 0;
+  std::uint32_t games = 0;          // games of the whole run, over all shards
+  std::uint32_t words = 0;          // size of the word table the games were played on
+  std::uint32_t dictionaryHash = 0; // of that word table
+  std::uint8_t strategy = 0;        // ShardFile::strategyFlags of the config
+};
+
+/**
+ * @brief One played game: its number within the run plus the record.
+ */
+struct ShardEntry {
+  std::uint32_t game = 0;
+  GameRecord record;
+};
+
+/**
+ * @brief Merged shards: the numbers Main prints after a simulation.
+ */
+struct MergedResults {
+  int games = 0;      // distinct games found
+  int missing = 0;    // games of the run that no shard contains
+  int duplicates = 0; // games found in more than one shard, counted once
+  int fails = 0;
+  std::array<int, Simulation::MAX_TRIES> tries{}; // tries[t - 1] = games won with t guesses
+  double averageTries = 0.0;                      // lost games count as MAX_TRIES + 1, like Main
+  double gameSeconds = 0.0;                       // sum of the per-game times
+};
+
+/**
+ * @brief Compact binary result file of one simulation shard.
+ *
+ * Little endian: magic "WRDS", version, header, entry count, then per entry
+ * game (u32), tries (u8), path length (u8), micros (u32), secret and path as word indices.
+ * Indices take 2 bytes if the word table has fewer than 65536 words, otherwise 4.
+ */
+class ShardFile {
+public:
+  static constexpr std::uint32_t VERSION = 1;
+
+  static std::uint32_t dictionaryHash(const WordTable& words);
+  static std::uint8_t strategyFlags(const StrategyConfig& config);
+
+  /**
+   * @brief Writes the shard atomically, so a crashed run never leaves a partial file.
+   */
+  static void write(const std::string& file, const ShardHeader& header, const std::vector<ShardEntry>& entries);
+  static std::vector<ShardEntry> read(const std::string& file, ShardHeader& header);
+
+  /**
+   * @brief Reads and combines any set of shards of one run.
+   * @throws std::runtime_error if a file is unreadable or the shards come from different runs.
+   */
+  static MergedResults merge(const std::vector<std::string>& files);
+};
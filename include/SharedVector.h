@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Copy-on-write vector: copies share one buffer until one of them is modified.
+ *
+ * Reading works like a const std::vector (it converts to one). Assigning a new vector
+ * replaces the buffer without touching the other copies, and mutate() copies the buffer
+ * first if it is still shared. A copy is a pointer copy, so forking a solver is O(1).
+ * A single SharedVector is not thread safe, distinct copies of one buffer are.
+ *
+ * Ownership is tracked explicitly instead of with use_count(): a copy marks both sides as
+ * shared, and only a buffer this SharedVector made itself is written in place. use_count()
+ * is a relaxed read that does not synchronize with another copy being released on a
+ * different thread, so it could let mutate() write while that copy still reads.
+ */
+template <typename T>
+class SharedVector {
+public:
+  SharedVector() : data(std::make_shared<std::vector<T>>()) {}
+  SharedVector(std::vector<T> values) : data(std::make_shared<std::vector<T>>(std::move(values))) {}
+  SharedVector(std::initializer_list<T> values) : data(std::make_shared<std::vector<T>>(values)) {}
+
+  SharedVector(const SharedVector& other) : data(other.data), exclusive(false) {
+    other.exclusive.store(false, std::memory_order_relaxed);
+  }
+  SharedVector(SharedVector&& other) noexcept
+      : data(std::move(other.data)), exclusive(other.exclusive.load(std::memory_order_relaxed)) {
+    other.data = std::make_shared<std::vector<T>>();
+    other.exclusive.store(true, std::memory_order_relaxed);
+  }
+  SharedVector& operator=(const SharedVector& other) {
+    if (this != &other) {
+      data = other.data;
+      exclusive.store(false, std::memory_order_relaxed);
+      other.exclusive.store(false, std::memory_order_relaxed);
+    }
+    return *this;
+  }
+  SharedVector& operator=(SharedVector&& other) noexcept {
+    if (this != &other) {
+      data = std::move(other.data);
+      exclusive.store(other.exclusive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other.data = std::make_shared<std::vector<T>>();
+      other.exclusive.store(true, std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  SharedVector& operator=(std::vector<T> values) {
+    data = std::make_shared<std::vector<T>>(std::move(values));
+    exclusive.store(true, std::memory_order_relaxed);
+    return *this;
+  }
+
+  operator const std::vector<T>&() const { return *data; }
+  [[nodiscard]] const std::vector<T>& get() const { return *data; }
+  [[nodiscard]] std::size_t size() const { return data->size(); }
+  [[nodiscard]] bool empty() const { return data->empty(); }
+  const T& operator[](std::size_t i) const { return (*data)[i]; }
+  [[nodiscard]] const T& front() const { return data->front(); }
+  [[nodiscard]] const T& back() const { return data->back(); }
+  [[nodiscard]] typename std::vector<T>::const_iterator begin() const { return data->cbegin(); }
+  [[nodiscard]] typename std::vector<T>::const_iterator end() const { return data->cend(); }
+
+  /**
+   * @brief Writable access; copies the buffer first unless this SharedVector owns it exclusively.
+   * Once copied from, a buffer is never written in place again, even if the copies are gone.
+   */
+  std::vector<T>& mutate() {
+    if (!exclusive.load(std::memory_order_relaxed)) {
+      data = std::make_shared<std::vector<T>>(*data);
+      exclusive.store(true, std::memory_order_relaxed);
+    }
+    return *data;
+  }
+  void push_back(const T& value) { mutate().push_back(value); }
+
+  /**
+   * @brief True if both use the same buffer, i.e. neither was modified since the copy.
+   */
+  [[nodiscard]] bool sharesWith(const SharedVector& other) const { return data == other.data; }
+
+private:
+  std::shared_ptr<std::vector<T>> data;
+  // False once a copy was made from or into this SharedVector; atomic because forking a const
+  // solver on several threads clears the flag of the same source concurrently
+  mutable std::atomic<bool> exclusive{true};
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AdversarialGame.h"
+#include "WordTable.h"
+#include "WordleSolver.h"
+
+/**
+ * @brief Solver settings a simulation runs with.
+ */
+struct StrategyConfig {
+  bool hardMode = false;
+  bool prefilter = true;
+  bool lookahead = true;
+  unsigned lookaheadThreads = 0; // 0 = hardware concurrency
+  std::shared_ptr<PatternTable> patternTable; // optional, shared by every solver (thread safe)
+
+  void applyTo(WordleSolver& solver) const;
+};
+
+/**
+ * @brief Outcome of one simulated game.
+ */
+struct GameRecord {
+  int secret = -1;       // index of the secret (adversary: the word it was forced to concede)
+  int tries = 0;         // guesses used, maxTries + 1 if the game was lost
+  bool solved = false;
+  std::vector<int> path; // indices of the guesses in order
+  std::uint32_t micros = 0; // wall time; in lockstep the game's share of the states it went through
+
+  /**
+   * @brief Sanity check for records read back from files: tries in 1..maxTries + 1, no more guesses than tries.
+   */
+  [[nodiscard]] bool isConsistent() const;
+};
+
+/**
+ * @brief Result of an exhaustive worst-case run over every secret.
+ */
+struct WorstCaseReport {
+  int maxTries = 0;              // maxTries + 1 means at least one game was lost
+  std::vector<int> worstSecrets; // secrets that need maxTries guesses
+  std::vector<int> histogram;    // histogram[t] = games with t tries, last entry = lost games
+  int fails = 0;
+  double averageTries = 0.0;     // lost games count as maxTries + 1, like Main
+  double seconds = 0.0;
+  std::size_t distinctStates = 0; // nextGuess calls, one per distinct solver state
+};
+
+/**
+ * @brief Periodic checkpoints of Simulation::playAll.
+ */
+struct CheckpointOptions {
+  std::string file;                  // empty = no checkpoints
+  std::chrono::seconds interval{30}; // minimum time between two checkpoints
+  bool resume = false;               // continue from file if it exists
+};
+
+/**
+ * @brief Runs solver games without any console I/O.
+ */
+class Simulation {
+public:
+  static constexpr int MAX_TRIES = 6;
+
+  /**
+   * @brief Plays one game against a fixed secret.
+   */
+  static GameRecord playGame(const std::shared_ptr<const WordTable>& words, int secret, const StrategyConfig& config);
+
+  /**
+   * @brief Plays one game against the adversary, which answers with its worst bucket.
+   */
+  static GameRecord playAdversary(const std::shared_ptr<const WordTable>& words, const StrategyConfig& config,
+                                  AdversarialGame::Policy policy = AdversarialGame::Policy::LargestBucket);
+
+  /**
+   * @brief Plays many secrets in lockstep, one turn at a time.
+   * Games with the same guess/feedback history share one solver state, so nextGuess runs
+   * once per distinct state instead of once per game (every game opens with the same guess).
+   * Same records as calling playGame for each secret.
+   * @param secrets Indices of the secrets; records[i] belongs to secrets[i].
+   * @param threads Worker threads across distinct states, 0 = hardware concurrency.
+   * @param distinctStates If set, receives the number of nextGuess calls.
+   * @param checkpoint If set, the run is snapshotted in the background and can resume from the file.
+   * Games that are not finished restart their timing at the checkpoint.
+   */
+  static std::vector<GameRecord> playAll(const std::shared_ptr<const WordTable>& words, const std::vector<int>& secrets,
+                                         const StrategyConfig& config, unsigned threads = 0,
+                                         std::size_t* distinctStates = nullptr,
+                                         const CheckpointOptions* checkpoint = nullptr);
+
+  /**
+   * @brief Plays every secret in lockstep and reports the worst case.
+   * The solver is deterministic, so this is the exact worst case of the strategy.
+   * @param threads Worker threads, 0 = hardware concurrency.
+   */
+  static WorstCaseReport analyzeWorstCase(const std::shared_ptr<const WordTable>& words, const StrategyConfig& config,
+                                          unsigned threads = 0);
+};
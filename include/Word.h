@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/// Every packed word has exactly this many letters.
+constexpr int WORD_LENGTH = 5;
+
+/**
+ * @brief Packs five letter indices (0 = 'a' ... 25 = 'z') into 5x5 bits.
+ * The first letter sits in the highest bits, so numeric order equals alphabetical order.
+ */
+constexpr std::uint32_t packLetters(int l0, int l1, int l2, int l3, int l4) {
+  return static_cast<std::uint32_t>(l0) << 20 | static_cast<std::uint32_t>(l1) << 15 |
+         static_cast<std::uint32_t>(l2) << 10 | static_cast<std::uint32_t>(l3) << 5 |
+         static_cast<std::uint32_t>(l4);
+}
+
+/**
+ * @brief Builds the 26-bit letter-set mask (bit i set <=> letter 'a'+i occurs) of packed letters.
+ */
+constexpr std::uint32_t letterMaskOf(std::uint32_t letters) {
+  std::uint32_t mask = 0;
+  for (int i = 0; i < WORD_LENGTH; ++i) {
+    mask |= 1u << (letters >> (5 * (WORD_LENGTH - 1 - i)) & 0x1F);
+  }
+  return mask;
+}
+
+/**
+ * @brief Canonical word representation used by every solver stage.
+ * 8 bytes per word: the packed letters plus the precomputed letter-set mask,
+ * so letter/position checks become register operations instead of string compares.
+ */
+struct Word {
+  std::uint32_t letters = 0;
+  std::uint32_t mask = 0;
+
+  /// Letter index (0..25) at position i.
+  [[nodiscard]] constexpr int letterAt(int i) const {
+    return static_cast<int>(letters >> (5 * (WORD_LENGTH - 1 - i)) & 0x1F);
+  }
+  [[nodiscard]] constexpr bool contains(int letter) const { return (mask >> letter & 1u) != 0; }
+
+  constexpr bool operator==(const Word& other) const { return letters == other.letters; }
+  constexpr bool operator!=(const Word& other) const { return letters != other.letters; }
+  constexpr bool operator<(const Word& other) const { return letters < other.letters; }
+};
+
+/**
+ * @brief Creates a Word (letters + mask) from already packed letters.
+ */
+constexpr Word makeWord(std::uint32_t letters) { return Word{letters, letterMaskOf(letters)}; }
+
+/**
+ * @brief Letter-count signature: 2 bits per letter, saturating at 3.
+ * No five-letter word in our lists repeats a letter four times, so 3 is exact in practice.
+ */
+using LetterCounts = std::uint64_t;
+
+constexpr LetterCounts letterCountsOf(Word word) {
+  LetterCounts counts = 0;
+  for (int i = 0; i < WORD_LENGTH; ++i) {
+    const int shift = 2 * word.letterAt(i);
+    if ((counts >> shift & 3u) != 3u) counts += LetterCounts{1} << shift;
+  }
+  return counts;
+}
+
+constexpr int letterCount(LetterCounts counts, int letter) {
+  return static_cast<int>(counts >> (2 * letter) & 3u);
+}
+
+/**
+ * @brief Packs a word string (upper or lower case) into a Word.
+ * @throws NotAFiveLetterWordException if the word does not have five letters.
+ * @throws NotAValidWordException if the word contains anything else than a-z.
+ */
+Word packWord(const std::string& word);
+
+/**
+ * @brief Converts a packed word back into its lowercase string (I/O boundary only).
+ */
+std::string unpackWord(Word word);
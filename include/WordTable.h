@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Word.h"
+
+/**
+ * @brief Sorted, de-duplicated table of packed words stored in contiguous arrays.
+ * All solver stages work on indices into this table; strings only appear at the I/O boundary.
+ */
+class WordTable {
+public:
+  WordTable() = default;
+  explicit WordTable(const std::vector<std::string>& wordList);
+  explicit WordTable(std::vector<Word> packedWords);
+
+  /**
+   * @brief The dictionary compiled into the binary (see cmake/EmbedDictionary.cmake).
+   * Built once on first use, no file I/O or parsing involved.
+   */
+  static std::shared_ptr<const WordTable> embedded();
+
+  [[nodiscard]] std::size_t size() const { return words.size(); }
+  [[nodiscard]] bool empty() const { return words.empty(); }
+  const Word& operator[](std::size_t index) const { return words[index]; }
+  [[nodiscard]] LetterCounts countsAt(std::size_t index) const { return counts[index]; }
+  [[nodiscard]] const std::vector<Word>& getWords() const { return words; }
+
+  [[nodiscard]] int indexOf(Word word) const;
+  [[nodiscard]] int indexOf(const std::string& word) const;
+  [[nodiscard]] std::string wordAt(std::size_t index) const { return unpackWord(words[index]); }
+
+  /// Sorted indices of all words with letter at position pos.
+  [[nodiscard]] const std::vector<int>& withLetterAt(int pos, int letter) const { return positionIndex[pos][letter]; }
+  /// Sorted indices of all words containing letter at least minCount (1..3) times.
+  [[nodiscard]] const std::vector<int>& withLetterCount(int letter, int minCount) const {
+    return countIndex[letter][minCount - 1];
+  }
+
+private:
+  void buildIndexes();
+
+  std::vector<Word> words;
+  std::vector<LetterCounts> counts;
+  // Posting lists for constraint queries (hard mode): intersect instead of rescanning the table
+  std::array<std::array<std::vector<int>, 26>, WORD_LENGTH> positionIndex;
+  std::array<std::array<std::vector<int>, 3>, 26> countIndex;
+};
@@ -1,30 +1,38 @@
 #pragma once
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 #include "FeedbackStrategy.h"
 #include "WordleExceptions.h"
+#include "WordTable.h"
 
 /**
  * @brief The WordleGame class encapsulates the logic for a Wordle game session.
  * It manages the secret word, number of tries, feedback calculation, and provides
  * utility methods for reading word lists and starting new games.
+ * The word list is a shared, immutable WordTable so a solver can use it without copying.
  */
 class WordleGame {
 private:
-    std::string secret;
+    std::shared_ptr<const WordTable> wordTable;
+    int secret;
     int tries;
 public:
-    std::vector<std::string> wordList;
     int maxTries = 6;
+    WordleGame();
     explicit WordleGame(const std::string& wordListFile);
+    WordleGame(std::shared_ptr<const WordTable> words, int secretIndex);
     std::vector<Feedback> guess(const std::string& word);
     static bool isWon(const std::vector<Feedback>& feedback) ;
     [[nodiscard]] int getTries() const; // why do you insist on calling Feedback strategy ???? I seriously do NOT get it. This will never result in 0 if guess isn't called in main. Am I supposed to change that architecture?
     [[nodiscard]] int getMaxTries() const;
     [[nodiscard]] int getWordLength() const;
-    [[nodiscard]] const std::string& getSecret() const { return secret; }
+    [[nodiscard]] std::string getSecret() const { return wordTable->wordAt(secret); }
+    [[nodiscard]] int getSecretIndex() const { return secret; }
+    [[nodiscard]] const std::shared_ptr<const WordTable>& getWordTable() const { return wordTable; }
     static std::vector<std::string> readWordList(const std::string& filename);
-    static std::string chooseRandomSecret(const std::vector<std::string>& wordList);
+    static int chooseRandomSecret(const WordTable& wordTable);
+    static int chooseRandomSecret(const WordTable& wordTable, std::mt19937_64& rng);
     std::unique_ptr<FeedbackStrategy> feedbackStrategy;
 };
@@ -1,60 +1,198 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 #include <array>
 #include "FeedbackStrategy.h"
+#include "LookaheadSearch.h"
+#include "PatternTable.h"
+#include "SharedVector.h"
 #include "WordleGame.h"
+#include "WordTable.h"
 
 class WordleSolver {
 
 public:
   int tries = 0;
-  std::vector<std::vector<Feedback>> storedFeedback = {};
-  std::vector<std::string> possibleWords = {};
-  std::vector<std::string> allWords = {};
-  std::unordered_set<char> absentLetters = {};
+  // The history and the candidate sets are copy-on-write, so fork() shares them until a fork diverges
+  SharedVector<Pattern> storedFeedback = {};
+  // Shared with the game, never copied. possibleWords holds indices into it.
+  std::shared_ptr<const WordTable> allWords;
+  SharedVector<int> possibleWords = {};
+  // Hard mode: every guess must reuse all revealed greens and yellows.
+  // legalGuesses is only narrowed in hard mode; setHardMode(true) rebuilds it from the constraints.
+  SharedVector<int> legalGuesses = {};
+  SharedVector<std::pair<Word, Pattern>> constraints = {}; // every filtered guess with its feedback
+  void setHardMode(bool enabled);
+  [[nodiscard]] bool isHardMode() const { return hardMode; }
+  // Bit i set -> letter 'a'+i is absent
+  std::uint32_t absentLetters = 0;
   std::array<int, 26> maxLetters;
   std::array<int, 26> oldPresentLetters = {};
-  std::unique_ptr<FeedbackStrategy> m_feedbackStrategy;
+  std::shared_ptr<FeedbackStrategy> m_feedbackStrategy;
   void updateFeedback(const std::vector<Feedback>& feedback);
+  void applyFeedback(const std::string& guess, const std::vector<Feedback>& feedback);
   explicit WordleSolver(std::unique_ptr<WordleGame> m_game);
+  WordleSolver(WordleSolver&&) = default;
+
+  /**
+   * @brief O(1) copy of the solver state for what-if analysis.
+   * The fork shares the word table, game, history and candidate sets with this solver; whichever
+   * of the two applies feedback first gets its own copy of what it changes, the other is unaffected.
+   * Options are copied, the lookahead memo starts empty.
+   */
+  [[nodiscard]] WordleSolver fork() const;
   std::string nextGuess();
+
+  /**
+   * @brief Settings for the anytime search of nextGuess(options).
+   */
+  struct AnytimeOptions {
+    std::chrono::microseconds budget{10000};
+    std::size_t sampleSize = 256; // solutions sampled per guess once there are more candidates
+    std::size_t refineCount = 16; // leading sampled guesses re-scored exactly while time remains
+    std::uint64_t seed = 0;       // same seed + same solver state -> same sample and guess
+  };
+  struct GuessResult {
+    std::string word;
+    double entropy = 0.0;       // of word; estimated from the sample unless exact
+    double standardError = 0.0; // of the sampled estimate, 0 if exact
+    bool exact = false;         // entropy was computed on all candidates; without sampling also: no guess was skipped
+    bool deadlineHit = false;   // the budget ran out before every stage finished
+    std::size_t evaluated = 0;  // guesses scored (sampled or exact)
+    std::size_t refined = 0;    // guesses re-scored exactly after sampling
+  };
+  GuessResult nextGuess(const AnytimeOptions& options);
+
+  /**
+   * @brief Settings of the cheap first pass of nextGuess(): every guess is scored by
+   * letter/positional frequency and only the top K get the exact entropy.
+   */
+  struct PrefilterOptions {
+    bool enabled = true;
+    std::size_t minCandidates = 64; // smaller sets are scored exactly right away
+    std::size_t baseK = 16;         // guesses that always get the exact entropy
+    std::size_t maxK = 64;          // K widens up to this while scores stay close
+    double tolerance = 0.02;        // "close": within 2% of the K-th score
+    std::size_t auditEvery = 0;     // every n-th prefiltered turn also runs the full scan (0 = never)
+  };
+  struct PrefilterStats {
+    std::size_t turns = 0;       // turns that used the prefilter
+    std::size_t shortlisted = 0; // sum of K over those turns
+    std::size_t audited = 0;     // turns checked against the full scan
+    std::size_t missed = 0;      // audited turns where the heuristic dropped the true best
+  };
+  PrefilterOptions prefilter;
+  const PrefilterStats& getPrefilterStats() const { return prefilterStats; }
+  std::vector<int> prefilterGuesses(const std::vector<int>& guesses) const;
+
+  /**
+   * @brief Settings of the lookahead search that nextGuess() uses for small candidate sets
+   * instead of entropy plus the probe word special cases.
+   */
+  struct LookaheadOptions {
+    bool enabled = true;
+    std::size_t maxCandidates = 32; // lookahead runs at or below this many candidates
+    unsigned threads = 0;           // 0 = std::thread::hardware_concurrency()
+  };
+  LookaheadOptions lookahead;
+
+  // Optional: cache-blocked entropy sweeps and a bounded row cache for large dictionaries
+  std::shared_ptr<PatternTable> patternTable;
   bool matchesFeedback(const std::string& word,
                                const std::string& guess,
                                const std::vector<Feedback>& feedback) const;
+  bool matchesFeedback(Word word, LetterCounts wordCounts, Word guess,
+                       const std::array<Feedback, WORD_LENGTH>& feedback) const;
   void updatePossibleWords(const std::string& guess,
                            const std::vector<Feedback>& feedback);
+  void updateLegalGuesses(Word guess, Pattern pattern);
   void addAbsentLetters(const std::string& guess,
                         const std::vector<Feedback>& feedback);
   void updateMaxLetters(const std::string& guess,
                     const std::vector<Feedback>& feedback);
-  std::array<int, 26> getLetterFrequency(const std::string& word,
-                   const std::vector<Feedback>& feedback, Feedback fdbk);
+  static std::array<int, 26> getLetterFrequency(Word word,
+                   const std::array<Feedback, WORD_LENGTH>& feedback, Feedback fdbk);
   struct ProbeInfo {
-    std::string word; // the probe word to guess
+    int word = -1;    // index of the probe word to guess
     int coverage = 0; // how many unknown letters it checks
   };
   ProbeInfo findProbeWord(const std::array<int, 26>& probeChars, const int& correctAmount);
-  int scoreProbe4Word(const std::string& word, const std::array<int, 26>& probeChars);
-  int scoreProbe3Word(const std::string& word, const std::array<int, 26>& probeChars);
-  const std::unordered_set<char>& getAbsentLetters() const { return absentLetters; }
+  int scoreProbe4Word(Word word, const std::array<int, 26>& probeChars) const;
+  int scoreProbe3Word(Word word, const std::array<int, 26>& probeChars) const;
+  std::uint32_t getAbsentLetters() const { return absentLetters; }
+  std::vector<std::string> getPossibleWords() const;
   std::vector<Feedback> feedbackPattern(const std::string& guess, const std::string& solution) const;
-  double calculateEntropy(const std::string& guess, const std::vector<std::string>& possibleWords) const;
+  double calculateEntropy(int guess, const std::vector<int>& candidates) const;
+
+  /**
+   * @brief One entry of rankGuesses().
+   */
+  struct RankedGuess {
+    std::string word;
+    double entropy = 0.0;
+    double expectedRemaining = 0.0; // candidates left on average after the guess
+    int worstBucket = 0;            // candidates left after the least helpful feedback
+  };
+  /**
+   * @brief The k guesses with the highest entropy, best first, ties in dictionary order.
+   * A separate exact scan of the pool of the entropy stage of nextGuess() (no prefilter, no lookahead);
+   * to show the alternatives of the guess actually played use rankingSize and getLastRanking().
+   */
+  std::vector<RankedGuess> rankGuesses(std::size_t k) const;
+
+  // Guesses nextGuess() keeps from its own entropy pass for getLastRanking(), 0 = none
+  std::size_t rankingSize = 0;
+  /**
+   * @brief Ranking of the last nextGuess() call, best first. The first entry is the guess it
+   * returned, the others are the runners-up of the same pass (none if the lookahead or the
+   * fixed opener picked the guess).
+   */
+  [[nodiscard]] const std::vector<RankedGuess>& getLastRanking() const { return lastRanking; }
+  static void printEntropyResults(const std::vector<RankedGuess>& entropyResults);
 
 private:
-  std::vector<Feedback> getStoredFeedback(int attempt) const;
+  struct SampledWord {
+    int word;      // index of the sampled solution
+    double weight; // how many candidates it stands for
+  };
+  std::vector<SampledWord> sampleCandidates(std::size_t sampleSize, std::uint64_t seed) const;
+  double estimateEntropy(int guess, const std::vector<SampledWord>& sample, double& standardError) const;
+  int applyProbeWord(int nextGuess);
+  const std::vector<int>& allowedGuesses() const { return hardMode ? legalGuesses : allGuesses; }
+  struct GuessScore {
+    int guess = -1;
+    double entropy = 0.0;
+    double expectedRemaining = 0.0;
+    int worstBucket = 0;
+  };
+  GuessScore scoreGuess(int guess, const std::vector<int>& candidates) const;
+  RankedGuess toRanked(const GuessScore& score) const;
+  int pickEntropyGuess(const std::vector<int>& guesses, double& maxEntropy);
+  std::vector<RankedGuess> lastRanking;
+  bool hardMode = false;
+  std::vector<GuessScore> topGuesses(const std::vector<int>& guesses, std::size_t k) const;
+  int bestEntropyGuess(const std::vector<int>& guesses, double& maxEntropy) const;
+  Pattern getStoredFeedback(int attempt) const;
   static std::string feedbackToString(const std::vector<Feedback>& feedback);
   void printGuessingInfo() const;
-  static void printEntropyResults(
-  const std::vector<std::pair<std::string, double>>& entropyResults);
   static void printBestGuess(const std::string& guess);
   static void printErrorNoMaximumEntropy();
 
-// save game as its object inside the class
-std::unique_ptr<WordleGame> game;
+  WordleSolver(const WordleSolver&) = default;
+
+// save game as its object inside the class, forks share it (the solver only reads it)
+std::shared_ptr<const WordleGame> game;
 
 const double   ENTROPY_THRESHOLD  = 1.0;
 
+PrefilterStats prefilterStats;
+std::shared_ptr<LookaheadSearch> lookaheadSearch; // never shared: fork() resets it
+// 0..n-1, the guess pool outside of hard mode
+SharedVector<int> allGuesses;
+
 };
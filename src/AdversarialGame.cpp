@@ -0,0 +1,83 @@
+#include "../include/AdversarialGame.h"
+#include "../include/WordleExceptions.h"
+#include <array>
+#include <utility>
+
+AdversarialGame::AdversarialGame(std::shared_ptr<const WordTable> words, Policy policy)
+    : words(std::move(words)), policy(policy) {
+  if (!this->words || this->words->empty()) {
+    throw WordListEmptyException();
+  }
+  candidates.resize(this->words->size());
+  for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+    candidates[i] = i;
+  }
+}
+
+/**
+ * @brief Evaluates a guess against the remaining candidates and returns the chosen feedback.
+ * @param word The guessed word.
+ * @return A vector of Feedback enums for each letter.
+ */
+std::vector<Feedback> AdversarialGame::guess(const std::string& word) {
+  return FeedbackStrategy::toFeedback(respond(packWord(word)));
+}
+
+/**
+ * @brief Packed version of guess: groups the candidates by feedback and keeps the worst group.
+ * @param guess The guessed word.
+ * @return The pattern of the kept group.
+ */
+Pattern AdversarialGame::respond(Word guess) {
+  if (tries >= maxTries) {
+    throw GuessLimitReachedException();
+  }
+  tries++;
+
+  // Same feedback computation as the solver
+  std::array<int, PATTERN_COUNT> bucketSize{};
+  for (const int candidate : candidates) {
+    bucketSize[FeedbackStrategy::calculatePattern(guess, (*words)[candidate])]++;
+  }
+
+  auto revealed = [](int pattern) {
+    int greens = 0;
+    int yellows = 0;
+    for (const Feedback f : FeedbackStrategy::decodePattern(static_cast<Pattern>(pattern))) {
+      greens += f == Feedback::Correct;
+      yellows += f == Feedback::Present;
+    }
+    return std::make_pair(greens, yellows);
+  };
+
+  int chosen = -1;
+  for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+    if (bucketSize[pattern] == 0) continue;
+    if (chosen == -1) {
+      chosen = pattern;
+      continue;
+    }
+    if (policy == Policy::MostDamaging && (chosen == ALL_CORRECT) != (pattern == ALL_CORRECT)) {
+      // Only concede the win if every other bucket is gone
+      if (chosen == ALL_CORRECT) chosen = pattern;
+      continue;
+    }
+    if (bucketSize[pattern] != bucketSize[chosen]) {
+      if (bucketSize[pattern] > bucketSize[chosen]) chosen = pattern;
+      continue;
+    }
+    if (policy == Policy::MostDamaging && revealed(pattern) < revealed(chosen)) {
+      chosen = pattern;
+    }
+  }
+
+  std::vector<int> kept;
+  kept.reserve(bucketSize[chosen]);
+  for (const int candidate : candidates) {
+    if (FeedbackStrategy::calculatePattern(guess, (*words)[candidate]) == chosen) {
+      kept.push_back(candidate);
+    }
+  }
+  candidates = std::move(kept);
+  return static_cast<Pattern>(chosen);
+}
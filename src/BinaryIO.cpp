@@ -0,0 +1,28 @@
+#include "../include/BinaryIO.h"
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define WORDLE_HAS_FSYNC 1
+#endif
+
+void writeFileAtomically(const std::string& file, const std::string& data) {
+  const std::string tmp = file + ".tmp";
+  std::FILE* stream = std::fopen(tmp.c_str(), "wb");
+  if (stream == nullptr) {
+    throw std::runtime_error("[ERROR] Could not create '" + tmp + "'.");
+  }
+  bool written = std::fwrite(data.data(), 1, data.size(), stream) == data.size() && std::fflush(stream) == 0;
+#ifdef WORDLE_HAS_FSYNC
+  // Without fsync the rename can reach the disk before the data after a crash
+  written = written && ::fsync(::fileno(stream)) == 0;
+#endif
+  written = std::fclose(stream) == 0 && written;
+  if (!written) {
+    std::remove(tmp.c_str());
+    throw std::runtime_error("[ERROR] Could not write '" + tmp + "'.");
+  }
+  if (std::rename(tmp.c_str(), file.c_str()) != 0) {
+    throw std::runtime_error("[ERROR] Could not rename '" + tmp + "' to '" + file + "'.");
+  }
+}
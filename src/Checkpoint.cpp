@@ -0,0 +1,202 @@
+#include "../include/Checkpoint.h"
+#include "../include/BinaryIO.h"
+#include "../include/ShardFile.h"
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr char MAGIC[4] = {'W', 'R', 'D', 'C'};
+
+void putIndices(std::string& out, const std::vector<int>& indices) {
+  putLittleEndian(out, indices.size(), 4);
+  for (const int index : indices) {
+    putLittleEndian(out, static_cast<std::uint32_t>(index), 4);
+  }
+}
+
+/**
+ * @brief Reads a list written by putIndices. The count is checked against maxCount and the
+ * bytes left before the list is allocated.
+ */
+std::vector<int> getIndices(LittleEndianReader& reader, const std::string& file,
+                            std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+  const std::size_t count = reader.getCount(4, 4);
+  if (count > maxCount) {
+    throw std::runtime_error("[ERROR] The checkpoint '" + file + "' is corrupt (list too long).");
+  }
+  std::vector<int> indices(count);
+  for (int& index : indices) {
+    index = static_cast<int>(reader.get(4));
+  }
+  return indices;
+}
+}
+
+std::uint64_t Checkpoint::runId(const WordTable& words, const std::vector<int>& secrets, const StrategyConfig& config) {
+  // FNV-1a over the dictionary hash, the strategy flags and the secrets
+  std::uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (8 * i)) & 0xFF;
+      hash *= 1099511628211ull;
+    }
+  };
+  mix(ShardFile::dictionaryHash(words));
+  mix(ShardFile::strategyFlags(config));
+  mix(secrets.size());
+  for (const int secret : secrets) {
+    mix(static_cast<std::uint64_t>(secret));
+  }
+  return hash;
+}
+
+void Checkpoint::write(const std::string& file, const LockstepSnapshot& snapshot) {
+  std::string out(MAGIC, sizeof(MAGIC));
+  putLittleEndian(out, VERSION, 4);
+  putLittleEndian(out, snapshot.sequence, 8);
+  putLittleEndian(out, snapshot.runId, 8);
+  putLittleEndian(out, snapshot.states, 8);
+  putIndices(out, snapshot.histogram);
+
+  putIndices(out, snapshot.finished);
+  for (const GameRecord& record : snapshot.records) {
+    putLittleEndian(out, static_cast<std::uint32_t>(record.secret), 4);
+    putLittleEndian(out, static_cast<std::uint8_t>(record.tries), 1);
+    putLittleEndian(out, record.micros, 4);
+    putIndices(out, record.path);
+  }
+
+  putLittleEndian(out, snapshot.pending.size(), 4);
+  for (const LockstepState& state : snapshot.pending) {
+    putIndices(out, state.path);
+    for (const Pattern pattern : state.feedback) {
+      putLittleEndian(out, pattern, 1);
+    }
+    putIndices(out, state.members);
+  }
+  writeFileAtomically(file, out);
+}
+
+bool Checkpoint::read(const std::string& file, LockstepSnapshot& snapshot) {
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  if (data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("[ERROR] '" + file + "' is not a checkpoint file.");
+  }
+
+  LittleEndianReader reader(data, file);
+  reader.get(sizeof(MAGIC));
+  if (reader.get(4) != VERSION) {
+    throw std::runtime_error("[ERROR] The checkpoint '" + file + "' has an unsupported version.");
+  }
+  snapshot.sequence = reader.get(8);
+  snapshot.runId = reader.get(8);
+  snapshot.states = reader.get(8);
+  snapshot.histogram = getIndices(reader, file, Simulation::MAX_TRIES + 2);
+  if (snapshot.histogram.size() != static_cast<std::size_t>(Simulation::MAX_TRIES + 2)) {
+    throw std::runtime_error("[ERROR] The checkpoint '" + file + "' is corrupt (invalid histogram).");
+  }
+
+  snapshot.finished = getIndices(reader, file);
+  snapshot.records.resize(snapshot.finished.size());
+  for (GameRecord& record : snapshot.records) {
+    record.secret = static_cast<int>(reader.get(4));
+    record.tries = static_cast<int>(reader.get(1));
+    record.micros = static_cast<std::uint32_t>(reader.get(4));
+    record.path = getIndices(reader, file, Simulation::MAX_TRIES);
+    record.solved = record.tries <= Simulation::MAX_TRIES;
+    if (!record.isConsistent()) {
+      throw std::runtime_error("[ERROR] The checkpoint '" + file + "' is corrupt (invalid game record).");
+    }
+  }
+
+  // Smallest pending state: two empty index lists
+  snapshot.pending.resize(reader.getCount(4, 8));
+  for (LockstepState& state : snapshot.pending) {
+    state.path = getIndices(reader, file, Simulation::MAX_TRIES);
+    state.feedback.resize(state.path.size());
+    for (Pattern& pattern : state.feedback) {
+      const std::uint64_t value = reader.get(1);
+      if (value > ALL_CORRECT) {
+        throw std::runtime_error("[ERROR] The checkpoint '" + file + "' is corrupt (invalid feedback).");
+      }
+      pattern = static_cast<Pattern>(value);
+    }
+    state.members = getIndices(reader, file);
+  }
+  if (!reader.done()) {
+    throw std::runtime_error("[ERROR] The checkpoint '" + file + "' has trailing data.");
+  }
+  return true;
+}
+
+CheckpointWriter::CheckpointWriter(std::string file) : file(std::move(file)), thread(&CheckpointWriter::run, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+  try {
+    finish();
+  } catch (const std::exception&) {
+    // Only the caller of finish() can act on a failed checkpoint
+  }
+}
+
+void CheckpointWriter::submit(LockstepSnapshot snapshot) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    waiting = std::make_unique<LockstepSnapshot>(std::move(snapshot));
+  }
+  wake.notify_one();
+}
+
+void CheckpointWriter::finish() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  if (thread.joinable()) {
+    thread.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  if (error) {
+    std::exception_ptr failed = error;
+    error = nullptr;
+    std::rethrow_exception(failed);
+  }
+}
+
+std::size_t CheckpointWriter::getWritten() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return written;
+}
+
+void CheckpointWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [this] { return waiting || stopping; });
+    if (!waiting) {
+      return;
+    }
+    const std::unique_ptr<LockstepSnapshot> snapshot = std::move(waiting);
+    // Serialization and disk I/O happen without the lock, submit never waits for them
+    lock.unlock();
+    std::exception_ptr failed;
+    try {
+      Checkpoint::write(file, *snapshot);
+    } catch (...) {
+      failed = std::current_exception();
+    }
+    lock.lock();
+    if (failed) {
+      if (!error) error = failed;
+    } else {
+      written++;
+    }
+  }
+}
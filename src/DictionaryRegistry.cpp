@@ -0,0 +1,96 @@
+#include "../include/DictionaryRegistry.h"
+#include "../include/WordleExceptions.h"
+#include "../include/WordleGame.h"
+#include <algorithm>
+#include <utility>
+
+DictionaryRegistry& DictionaryRegistry::instance() {
+  static DictionaryRegistry registry;
+  return registry;
+}
+
+DictionaryRegistry::Handle DictionaryRegistry::get(const std::string& name) {
+  if (Handle dictionary = find(name)) {
+    return dictionary;
+  }
+  std::lock_guard<std::mutex> loading(loadMutex);
+  // Another thread may have loaded it while this one waited
+  if (Handle dictionary = find(name)) {
+    return dictionary;
+  }
+  Handle dictionary = build(name, load(name));
+  std::lock_guard<std::mutex> lock(mutex);
+  current[name] = dictionary;
+  return dictionary;
+}
+
+DictionaryRegistry::Handle DictionaryRegistry::reload(const std::string& name) {
+  std::lock_guard<std::mutex> loading(loadMutex);
+  Handle dictionary = build(name, load(name));
+  std::lock_guard<std::mutex> lock(mutex);
+  current[name] = dictionary;
+  return dictionary;
+}
+
+DictionaryRegistry::Handle DictionaryRegistry::publish(const std::string& name, std::shared_ptr<const WordTable> words) {
+  if (!words || words->empty()) {
+    throw WordListEmptyException();
+  }
+  std::lock_guard<std::mutex> loading(loadMutex);
+  Handle dictionary = build(name, std::move(words));
+  std::lock_guard<std::mutex> lock(mutex);
+  current[name] = dictionary;
+  return dictionary;
+}
+
+DictionaryRegistry::Handle DictionaryRegistry::find(const std::string& name) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto it = current.find(name);
+  return it == current.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> DictionaryRegistry::names() const {
+  std::vector<std::string> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : current) result.push_back(entry.first);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void DictionaryRegistry::enablePatternTables(PatternTable::Options options) {
+  std::lock_guard<std::mutex> lock(mutex);
+  patternOptions = std::move(options);
+}
+
+/**
+ * @brief Wraps a table into a new version. Runs without the registry lock, so readers
+ * keep getting the current version while a pattern table is set up.
+ */
+DictionaryRegistry::Handle DictionaryRegistry::build(const std::string& name, std::shared_ptr<const WordTable> words) {
+  auto dictionary = std::make_shared<Dictionary>();
+  dictionary->name = name;
+  dictionary->words = std::move(words);
+  std::optional<PatternTable::Options> options;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    dictionary->version = ++lastVersion;
+    options = patternOptions;
+  }
+  if (options) {
+    dictionary->patterns = std::make_shared<PatternTable>(dictionary->words, *options);
+  }
+  return dictionary;
+}
+
+std::shared_ptr<const WordTable> DictionaryRegistry::load(const std::string& name) {
+  if (name == EMBEDDED) {
+    return WordTable::embedded();
+  }
+  auto words = std::make_shared<const WordTable>(WordleGame::readWordList(name));
+  if (words->empty()) {
+    throw WordListEmptyException();
+  }
+  return words;
+}
@@ -1,6 +1,7 @@
 #include "../include/FeedbackStrategy.h"
 #include <vector>
 #include <string>
+#include <stdexcept>
 
 /**
  * @brief Calculates the feedback for a guess compared to the solution.
@@ -30,3 +31,70 @@ std::vector<Feedback> FeedbackStrategy::calculateFeedback(const std::string& gue
     }
     return feedback;
 }
+
+/**
+ * @brief Calculates the feedback pattern of two packed words.
+ * Same rules as calculateFeedback: Correct letters first, then Present letters consume
+ * the remaining unmatched solution letters from left to right.
+ * @param guess The guessed word.
+ * @param solution The solution word.
+ * @return The base-3 encoded pattern.
+ */
+Pattern FeedbackStrategy::calculatePattern(Word guess, Word solution) {
+    static constexpr int POW3[WORD_LENGTH] = {1, 3, 9, 27, 81};
+    // No shared letter at all -> everything Absent, the most common case for large candidate sets
+    if ((guess.mask & solution.mask) == 0) return 0;
+
+    int g[WORD_LENGTH];
+    int s[WORD_LENGTH];
+    int code = 0;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        g[i] = guess.letterAt(i);
+        s[i] = solution.letterAt(i);
+        if (g[i] == s[i]) {
+            code += 2 * POW3[i];
+            g[i] = -1;  // done
+            s[i] = -2;  // consumed
+        }
+    }
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (g[i] < 0) continue;
+        for (int j = 0; j < WORD_LENGTH; ++j) {
+            if (g[i] == s[j]) {
+                code += POW3[i];
+                s[j] = -2;
+                break;
+            }
+        }
+    }
+    return static_cast<Pattern>(code);
+}
+
+Pattern FeedbackStrategy::toPattern(const std::vector<Feedback>& feedback) {
+    if (feedback.size() != WORD_LENGTH) {
+        throw std::runtime_error("Invalid feedback size!");
+    }
+    int code = 0;
+    for (int i = WORD_LENGTH - 1; i >= 0; --i) {
+        code *= 3;
+        if (feedback[i] == Feedback::Correct) code += 2;
+        else if (feedback[i] == Feedback::Present) code += 1;
+    }
+    return static_cast<Pattern>(code);
+}
+
+std::array<Feedback, WORD_LENGTH> FeedbackStrategy::decodePattern(Pattern pattern) {
+    std::array<Feedback, WORD_LENGTH> feedback{};
+    int code = pattern;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        const int digit = code % 3;
+        code /= 3;
+        feedback[i] = digit == 2 ? Feedback::Correct : digit == 1 ? Feedback::Present : Feedback::Absent;
+    }
+    return feedback;
+}
+
+std::vector<Feedback> FeedbackStrategy::toFeedback(Pattern pattern) {
+    const auto decoded = decodePattern(pattern);
+    return {decoded.begin(), decoded.end()};
+}
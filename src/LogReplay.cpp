@@ -0,0 +1,363 @@
+#include "../include/LogReplay.h"
+#include "../include/BinaryIO.h"
+#include "../include/ShardFile.h"
+#include "../include/WordleSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+constexpr char MAGIC[4] = {'W', 'R', 'D', 'R'};
+
+struct PendingLine {
+  std::uint64_t line = 0;
+  std::string text;
+  bool tooLong = false;
+};
+
+/**
+ * @brief A run of consecutive log lines; the worker fills output and stats.
+ */
+struct Batch {
+  std::uint64_t sequence = 0;
+  std::vector<PendingLine> lines;
+  std::string output;
+  LogReplay::Stats stats;
+};
+
+int indexBytes(std::size_t words) { return words < 65536 ? 2 : 4; }
+
+std::uint16_t millibits(double entropy) {
+  return static_cast<std::uint16_t>(std::min(65535.0, std::round(entropy * 1000.0)));
+}
+
+void appendMove(std::string& out, const ReplayedMove& move, int width) {
+  putLittleEndian(out, move.line, 8);
+  putLittleEndian(out, static_cast<std::uint8_t>(move.move), 1);
+  putLittleEndian(out, static_cast<std::uint8_t>(move.status), 1);
+  putLittleEndian(out, move.feedback, 1);
+  putLittleEndian(out, static_cast<std::uint32_t>(move.candidatesBefore), 4);
+  putLittleEndian(out, static_cast<std::uint32_t>(move.candidatesAfter), 4);
+  putLittleEndian(out, millibits(move.guessEntropy), 2);
+  putLittleEndian(out, millibits(move.solverEntropy), 2);
+  // Unparsable lines have no words, -1 is stored as all ones
+  putLittleEndian(out, static_cast<std::uint32_t>(move.guess), width);
+  putLittleEndian(out, static_cast<std::uint32_t>(move.solverGuess), width);
+}
+}
+
+bool LogReplay::ChoiceCache::find(const std::string& history, int& guess, double& entropy) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto it = choices.find(history);
+  if (it == choices.end()) return false;
+  guess = it->second.first;
+  entropy = it->second.second;
+  return true;
+}
+
+void LogReplay::ChoiceCache::insert(const std::string& history, int guess, double entropy) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (choices.size() < capacity) {
+    choices.emplace(history, std::make_pair(guess, entropy));
+  }
+}
+
+LoggedGame LogReplay::parseLine(const std::string& text, std::uint64_t line, const WordTable& words) {
+  LoggedGame game;
+  game.line = line;
+  std::istringstream tokens(text);
+  std::string token;
+  while (tokens >> token) {
+    if (token.size() != WORD_LENGTH * 2 + 1 || token[WORD_LENGTH] != ':') {
+      game.error = "move '" + token + "' is not guess:feedback";
+      return game;
+    }
+    const int guess = words.indexOf(token.substr(0, WORD_LENGTH));
+    if (guess < 0) {
+      game.error = "'" + token.substr(0, WORD_LENGTH) + "' is not in the word list";
+      return game;
+    }
+    std::vector<Feedback> feedback;
+    for (std::size_t i = WORD_LENGTH + 1; i < token.size(); ++i) {
+      if (token[i] == '2') feedback.push_back(Feedback::Correct);
+      else if (token[i] == '1') feedback.push_back(Feedback::Present);
+      else if (token[i] == '0') feedback.push_back(Feedback::Absent);
+      else {
+        game.error = "feedback of '" + token + "' is not made of 0, 1 and 2";
+        return game;
+      }
+    }
+    if (!game.feedback.empty() && game.feedback.back() == ALL_CORRECT) {
+      game.error = "moves after the solution was found";
+      return game;
+    }
+    game.guesses.push_back(guess);
+    game.feedback.push_back(FeedbackStrategy::toPattern(feedback));
+  }
+  if (game.guesses.size() > static_cast<std::size_t>(Simulation::MAX_TRIES)) {
+    game.error = "more than " + std::to_string(Simulation::MAX_TRIES) + " moves";
+  }
+  return game;
+}
+
+/**
+ * @brief Rebuilds the game move by move with the solver's own filtering and scores each move.
+ * Stops at the first feedback that contradicts the history.
+ */
+std::vector<ReplayedMove> LogReplay::replayGame(const LoggedGame& game, const std::shared_ptr<const WordTable>& words,
+                                                const StrategyConfig& config, ChoiceCache* cache,
+                                                std::uint64_t* cacheHits) {
+  std::vector<ReplayedMove> moves;
+  if (!game.error.empty()) {
+    ReplayedMove move;
+    move.line = game.line;
+    move.status = ReplayedMove::Status::Unparsable;
+    moves.push_back(move);
+    return moves;
+  }
+
+  // The solver only needs the game for the word table and try limit
+  WordleSolver solver(std::make_unique<WordleGame>(words, 0));
+  config.applyTo(solver);
+  std::string history; // cache key: the moves so far
+  for (std::size_t m = 0; m < game.guesses.size(); ++m) {
+    ReplayedMove move;
+    move.line = game.line;
+    move.move = static_cast<int>(m);
+    move.guess = game.guesses[m];
+    move.feedback = game.feedback[m];
+    move.candidatesBefore = static_cast<int>(solver.possibleWords.size());
+
+    // The solver's choice comes from a fork, the replayed state only sees the human moves
+    if (cache != nullptr && cache->find(history, move.solverGuess, move.solverEntropy)) {
+      if (cacheHits != nullptr) (*cacheHits)++;
+    } else {
+      WordleSolver probe = solver.fork();
+      move.solverGuess = words->indexOf(packWord(probe.nextGuess()));
+      move.solverEntropy = solver.calculateEntropy(move.solverGuess, solver.possibleWords);
+      if (cache != nullptr) cache->insert(history, move.solverGuess, move.solverEntropy);
+    }
+    move.guessEntropy = solver.calculateEntropy(move.guess, solver.possibleWords);
+    putLittleEndian(history, static_cast<std::uint32_t>(move.guess), 4);
+    putLittleEndian(history, move.feedback, 1);
+
+    bool consistent = true;
+    if (move.feedback == ALL_CORRECT) {
+      // applyFeedback does not filter a won game, so check the solution against the candidates here
+      consistent = std::binary_search(solver.possibleWords.begin(), solver.possibleWords.end(), move.guess);
+      move.candidatesAfter = consistent ? 1 : 0;
+    } else {
+      try {
+        solver.tries++;
+        solver.applyFeedback(words->wordAt(move.guess), FeedbackStrategy::toFeedback(move.feedback));
+        move.candidatesAfter = static_cast<int>(solver.possibleWords.size());
+      } catch (const std::logic_error&) {
+        // updatePossibleWords found no candidate left
+        consistent = false;
+      }
+    }
+    if (!consistent) {
+      move.status = ReplayedMove::Status::Inconsistent;
+      moves.push_back(move);
+      break;
+    }
+    moves.push_back(move);
+  }
+  return moves;
+}
+
+LogReplay::Stats LogReplay::run(const std::string& logFile, const std::string& outFile,
+                                const std::shared_ptr<const WordTable>& words, const StrategyConfig& config,
+                                Options options) {
+  const auto start = std::chrono::steady_clock::now();
+  std::ifstream in(logFile, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("[ERROR] Could not open the game log '" + logFile + "'.");
+  }
+  std::ofstream out(outFile, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("[ERROR] Could not create '" + outFile + "'.");
+  }
+  std::string header(MAGIC, sizeof(MAGIC));
+  putLittleEndian(header, VERSION, 4);
+  putLittleEndian(header, words->size(), 4);
+  putLittleEndian(header, ShardFile::dictionaryHash(*words), 4);
+  out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  unsigned threads = options.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : options.threads;
+  // Parallelism is across games; the lookahead inside each game stays single threaded
+  StrategyConfig gameConfig = config;
+  if (threads > 1) {
+    gameConfig.lookaheadThreads = 1;
+  }
+  const int width = indexBytes(words->size());
+  ChoiceCache cache(options.cachedStates);
+  // Batches that are read but not written yet; this bounds the memory of the whole pipeline
+  const std::size_t maxInFlight = 2 * static_cast<std::size_t>(threads) + 2;
+
+  std::mutex mutex;
+  std::condition_variable workReady;
+  std::condition_variable batchDone;
+  std::condition_variable slotFree;
+  std::deque<std::unique_ptr<Batch>> work;
+  std::map<std::uint64_t, std::unique_ptr<Batch>> finished;
+  std::size_t inFlight = 0;
+  bool inputDone = false;
+  Stats stats;
+
+  auto worker = [&]() {
+    while (true) {
+      std::unique_ptr<Batch> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        workReady.wait(lock, [&] { return !work.empty() || inputDone; });
+        if (work.empty()) return;
+        batch = std::move(work.front());
+        work.pop_front();
+      }
+      for (const PendingLine& line : batch->lines) {
+        LoggedGame game;
+        if (line.tooLong) {
+          game.line = line.line;
+          game.error = "line too long";
+        } else {
+          game = parseLine(line.text, line.line, *words);
+        }
+        std::vector<ReplayedMove> moves;
+        try {
+          moves = replayGame(game, words, gameConfig, &cache, &batch->stats.cacheHits);
+        } catch (const std::exception&) {
+          game.error = "replay failed";
+          moves = replayGame(game, words, gameConfig);
+        }
+        if (!game.error.empty()) {
+          batch->stats.unparsable++;
+        } else {
+          batch->stats.games++;
+          batch->stats.moves += moves.size();
+          if (moves.back().status == ReplayedMove::Status::Inconsistent) batch->stats.inconsistent++;
+        }
+        for (const ReplayedMove& move : moves) {
+          if (move.status == ReplayedMove::Status::Ok && move.guess == move.solverGuess) batch->stats.agreed++;
+          appendMove(batch->output, move, width);
+        }
+      }
+      batch->lines.clear();
+      std::lock_guard<std::mutex> lock(mutex);
+      const std::uint64_t sequence = batch->sequence;
+      finished.emplace(sequence, std::move(batch));
+      batchDone.notify_all();
+    }
+  };
+
+  // Writes the batches in input order, whatever order the workers finish them in
+  auto writer = [&]() {
+    std::uint64_t next = 0;
+    while (true) {
+      std::unique_ptr<Batch> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchDone.wait(lock, [&] { return finished.count(next) > 0 || (inputDone && inFlight == 0); });
+        const auto it = finished.find(next);
+        if (it == finished.end()) return;
+        batch = std::move(it->second);
+        finished.erase(it);
+      }
+      out.write(batch->output.data(), static_cast<std::streamsize>(batch->output.size()));
+      stats.games += batch->stats.games;
+      stats.moves += batch->stats.moves;
+      stats.unparsable += batch->stats.unparsable;
+      stats.inconsistent += batch->stats.inconsistent;
+      stats.agreed += batch->stats.agreed;
+      stats.cacheHits += batch->stats.cacheHits;
+      next++;
+      std::lock_guard<std::mutex> lock(mutex);
+      inFlight--;
+      slotFree.notify_one();
+      batchDone.notify_all();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned id = 0; id < threads; ++id) {
+    pool.emplace_back(worker);
+  }
+  std::thread writerThread(writer);
+
+  std::uint64_t sequence = 0;
+  auto batch = std::make_unique<Batch>();
+  auto submit = [&]() {
+    batch->sequence = sequence++;
+    std::unique_lock<std::mutex> lock(mutex);
+    slotFree.wait(lock, [&] { return inFlight < maxInFlight; });
+    inFlight++;
+    work.push_back(std::move(batch));
+    workReady.notify_one();
+    batch = std::make_unique<Batch>();
+  };
+  auto emit = [&](PendingLine line) {
+    if (!line.tooLong) {
+      if (!line.text.empty() && line.text.back() == '\r') line.text.pop_back();
+      const std::size_t first = line.text.find_first_not_of(" \t");
+      if (first == std::string::npos || line.text[first] == '#') return;
+    }
+    batch->lines.push_back(std::move(line));
+    if (batch->lines.size() >= options.batchGames) submit();
+  };
+
+  // Chunked read: only one chunk and the current line are held, lines longer than the cap are dropped
+  std::vector<char> chunk(std::max<std::size_t>(1, options.chunkBytes));
+  PendingLine current;
+  std::uint64_t lineNumber = 0;
+  while (in.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || in.gcount() > 0) {
+    const char* pos = chunk.data();
+    const char* end = pos + in.gcount();
+    while (pos < end) {
+      const char* newline = std::find(pos, end, '\n');
+      if (!current.tooLong) {
+        if (current.text.size() + static_cast<std::size_t>(newline - pos) > options.maxLineBytes) {
+          current.tooLong = true;
+          current.text.clear();
+        } else {
+          current.text.append(pos, newline);
+        }
+      }
+      if (newline == end) break;
+      current.line = ++lineNumber;
+      emit(std::move(current));
+      current = PendingLine();
+      pos = newline + 1;
+    }
+  }
+  if (!current.text.empty() || current.tooLong) {
+    current.line = ++lineNumber;
+    emit(std::move(current));
+  }
+  if (!batch->lines.empty()) submit();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    inputDone = true;
+  }
+  workReady.notify_all();
+  batchDone.notify_all();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  writerThread.join();
+
+  out.close();
+  if (!out) {
+    throw std::runtime_error("[ERROR] Could not write '" + outFile + "'.");
+  }
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
@@ -0,0 +1,231 @@
+#include "../include/LookaheadSearch.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+LookaheadSearch::LookaheadSearch(std::shared_ptr<const WordTable> words, unsigned threads)
+    : words(std::move(words)), threads(threads) {
+  if (this->threads == 0) {
+    this->threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+std::size_t LookaheadSearch::StateHash::operator()(const std::vector<int>& state) const {
+  // FNV-1a over the indices
+  std::size_t hash = 1469598103934665603ull;
+  for (const int value : state) {
+    hash ^= static_cast<std::size_t>(value);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/**
+ * @brief Lower bound for states beyond the second ply: guess the candidates one by one.
+ */
+double LookaheadSearch::leafEstimate(std::size_t size, int triesLeft) {
+  if (triesLeft <= 0 || size == 0) return 0.0;
+  return std::min(1.0, static_cast<double>(triesLeft) / static_cast<double>(size));
+}
+
+bool LookaheadSearch::isBetter(const Result& a, const Result& b) {
+  if (b.guess == -1) return a.guess != -1;
+  if (a.solveProbability != b.solveProbability) return a.solveProbability > b.solveProbability;
+  if (a.quickSolveProbability != b.quickSolveProbability) return a.quickSolveProbability > b.quickSolveProbability;
+  if (a.inCandidates != b.inCandidates) return a.inCandidates;
+  if (a.buckets != b.buckets) return a.buckets > b.buckets;
+  return a.guess < b.guess;
+}
+
+LookaheadSearch::Result LookaheadSearch::search(const std::vector<int>& candidates, const std::vector<int>& guesses,
+                                                const std::vector<int>& followUps, int triesLeft) {
+  Result best;
+  if (candidates.empty() || triesLeft <= 0) return best;
+  if (candidates.size() == 1) {
+    return {candidates.front(), 1.0, 1.0, true, 1};
+  }
+
+  // Memoized sub-states are only valid for the follow-up pool they were searched with
+  const std::size_t hash = StateHash{}(followUps);
+  if (hash != poolHash) {
+    clearMemo();
+    poolHash = hash;
+  }
+
+  // Upper bound of the pattern computations: every root guess splits the candidates and
+  // every bucket is searched with the follow-up pool. Small searches would mostly pay for
+  // starting threads, so they get fewer (or none) of them.
+  const double work = static_cast<double>(guesses.size()) * static_cast<double>(candidates.size()) *
+                      static_cast<double>(followUps.size() + 1);
+  const auto useThreads = static_cast<unsigned>(std::clamp(work / MIN_WORK_PER_THREAD, 1.0, static_cast<double>(threads)));
+
+  // Alpha: best value any worker found so far. Guesses that cannot reach it are cut off.
+  std::atomic<double> alpha{0.0};
+  std::atomic<std::size_t> next{0};
+  std::vector<Result> bestPerThread(useThreads);
+
+  auto worker = [&](unsigned id) {
+    for (std::size_t i = next++; i < guesses.size(); i = next++) {
+      const Result result = evaluateGuess(guesses[i], candidates, followUps, triesLeft, alpha.load());
+      if (result.guess == -1) continue;
+      if (isBetter(result, bestPerThread[id])) bestPerThread[id] = result;
+      double seen = alpha.load();
+      while (result.solveProbability > seen && !alpha.compare_exchange_weak(seen, result.solveProbability)) {
+      }
+    }
+  };
+
+  if (useThreads == 1) {
+    worker(0);
+  } else {
+    std::vector<std::thread> pool;
+    for (unsigned id = 0; id < useThreads; ++id) {
+      pool.emplace_back(worker, id);
+    }
+    for (auto& thread : pool) {
+      thread.join();
+    }
+  }
+
+  // Pruned guesses are strictly worse than some kept one, so the merge is deterministic
+  for (const auto& result : bestPerThread) {
+    if (isBetter(result, best)) best = result;
+  }
+  return best;
+}
+
+/**
+ * @brief Root ply for one guess: split the candidates and search every bucket.
+ * @return The scored guess, or guess == -1 if it was cut off below alpha.
+ */
+LookaheadSearch::Result LookaheadSearch::evaluateGuess(int guess, const std::vector<int>& candidates,
+                                                       const std::vector<int>& guesses, int triesLeft, double alpha) {
+  const Word guessWord = (*words)[guess];
+  std::vector<std::pair<Pattern, int>> patterns;
+  patterns.reserve(candidates.size());
+  for (const int candidate : candidates) {
+    patterns.emplace_back(FeedbackStrategy::calculatePattern(guessWord, (*words)[candidate]), candidate);
+  }
+  std::sort(patterns.begin(), patterns.end());
+
+  Result result;
+  result.guess = guess;
+  std::vector<std::vector<int>> buckets;
+  for (std::size_t i = 0; i < patterns.size();) {
+    std::size_t j = i;
+    while (j < patterns.size() && patterns[j].first == patterns[i].first) ++j;
+    result.buckets++;
+    if (patterns[i].first == ALL_CORRECT) {
+      result.inCandidates = true;
+    } else {
+      std::vector<int> bucket;
+      bucket.reserve(j - i);
+      for (std::size_t k = i; k < j; ++k) bucket.push_back(patterns[k].second);
+      buckets.push_back(std::move(bucket));
+    }
+    i = j;
+  }
+
+  // Largest buckets first: they decide the value and trigger the cutoff earliest
+  std::sort(buckets.begin(), buckets.end(),
+            [](const std::vector<int>& a, const std::vector<int>& b) { return a.size() > b.size(); });
+
+  result.solveProbability = bucketValue(buckets, result.inCandidates, candidates.size(), guesses, triesLeft, alpha);
+  if (result.solveProbability < 0.0) {
+    result.guess = -1;
+    return result;
+  }
+  // Only guesses that can still tie the best need the tie-breaker
+  result.quickSolveProbability = triesLeft > 3
+      ? bucketValue(buckets, result.inCandidates, candidates.size(), guesses, 3, 0.0)
+      : result.solveProbability;
+  return result;
+}
+
+/**
+ * @brief Value of a root guess from its buckets: 1/|S| * ([g in S] + sum |B| * f(B, t - 1)).
+ * @return The value, or -1 if it was cut off below alpha.
+ */
+double LookaheadSearch::bucketValue(const std::vector<std::vector<int>>& buckets, bool inCandidates, std::size_t total,
+                                    const std::vector<int>& guesses, int triesLeft, double alpha) {
+  const double size = static_cast<double>(total);
+  double solved = inCandidates ? 1.0 : 0.0;
+  double open = size - solved;
+  for (const auto& bucket : buckets) {
+    // Even if every remaining bucket were solved for sure, this guess could not reach alpha
+    if ((solved + open) / size < alpha - 1e-12) {
+      return -1.0;
+    }
+    const double bucketSize = static_cast<double>(bucket.size());
+    solved += bucketSize * solveProbability(bucket, guesses, triesLeft - 1);
+    open -= bucketSize;
+  }
+  return solved / size;
+}
+
+/**
+ * @brief Second ply: f(B, t) with the best follow-up guess, memoized per sub-state.
+ */
+double LookaheadSearch::solveProbability(const std::vector<int>& candidates, const std::vector<int>& guesses,
+                                         int triesLeft) {
+  if (triesLeft <= 0) return 0.0;
+  if (candidates.size() == 1) return 1.0;
+  if (triesLeft == 1) return 1.0 / static_cast<double>(candidates.size());
+
+  std::vector<int> key(candidates);
+  key.push_back(triesLeft);
+  {
+    std::lock_guard<std::mutex> lock(memoMutex);
+    const auto it = memo.find(key);
+    if (it != memo.end()) return it->second;
+  }
+
+  const double total = static_cast<double>(candidates.size());
+  double best = 0.0;
+  std::array<int, PATTERN_COUNT> counts{};
+  std::vector<Pattern> touched;
+  touched.reserve(candidates.size());
+
+  auto score = [&](int guess) {
+    const Word guessWord = (*words)[guess];
+    touched.clear();
+    for (const int candidate : candidates) {
+      const Pattern pattern = FeedbackStrategy::calculatePattern(guessWord, (*words)[candidate]);
+      if (counts[pattern]++ == 0) touched.push_back(pattern);
+    }
+    double solved = 0.0;
+    for (const Pattern pattern : touched) {
+      solved += pattern == ALL_CORRECT ? 1.0 : counts[pattern] * leafEstimate(counts[pattern], triesLeft - 1);
+      counts[pattern] = 0;
+    }
+    return solved / total;
+  };
+
+  // Candidates first: they usually reach 1.0 and let the scan stop early
+  for (const int guess : candidates) {
+    best = std::max(best, score(guess));
+    if (best >= 1.0) break;
+  }
+  if (best < 1.0) {
+    for (const int guess : guesses) {
+      best = std::max(best, score(guess));
+      if (best >= 1.0) break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(memoMutex);
+  memo.emplace(std::move(key), best);
+  return best;
+}
+
+void LookaheadSearch::clearMemo() {
+  std::lock_guard<std::mutex> lock(memoMutex);
+  memo.clear();
+}
+
+std::size_t LookaheadSearch::memoSize() const {
+  std::lock_guard<std::mutex> lock(memoMutex);
+  return memo.size();
+}
@@ -1,12 +1,20 @@
 #include "../include/WordleGame.h"
 #include "../include/WordleSolver.h"
 #include "../include/FeedbackStrategy.h"
+#include "../include/Simulation.h"
+#include "../include/ShardFile.h"
+#include "../include/DictionaryRegistry.h"
+#include "../include/CommandLine.h"
 #include <vector>
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <ostream>
 #include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
 #include <random>
 #include <memory>
 
@@ -22,6 +30,13 @@ static std::string feedbackToString(const std::vector<Feedback>& feedback) {
   return s;
 }
 
+static void printPatternStats(const StrategyConfig& strategy) {
+  if (!strategy.patternTable) return;
+  const PatternTable::Stats stats = strategy.patternTable->getStats();
+  std::cout << "[INFO] Pattern rows: " << stats.hits << " hits, " << stats.misses << " misses, "
+            << stats.cachedRows << " cached, " << stats.spillWrites << " spilled, " << stats.spillReads << " read back" << std::endl;
+}
+
 static std::vector<Feedback> StringToFeedback(std::string fdbkString) {
   std::vector<Feedback> fdbk;
   for (const auto fdbk_char : fdbkString) {
@@ -39,12 +54,153 @@ static std::vector<Feedback> StringToFeedback(std::string fdbkString) {
 
 
 
-int main() {
+int main(int argc, char* argv[]) {
+  // Usage: assignment_main [--hard] [--pattern-cache MiB] [--scratch prefix] [--seed S]
+  //                        [--shard i/N --out file [--runs R | --every-secret]]
+  //                        [--checkpoint-every S] [--resume] [word list file]
+  bool hardMode = false;
+  std::string wordListFile;
+  std::size_t patternCacheMiB = 0;
+  std::string scratchFile;
+  std::uint64_t seed = std::random_device{}();
+  ShardSpec shard;
+  std::string outFile;
+  int batchRuns = 4000;
+  bool everySecret = false;
+  CheckpointOptions checkpoint;
+  for (int a = 1; a < argc; ++a) {
+    const std::string arg = argv[a];
+    if (arg == "--hard") {
+      hardMode = true;
+    } else if (arg == "--seed" && a + 1 < argc) {
+      if (!parseNumber(argv[++a], 0, UINT64_MAX, seed)) {
+        std::cerr << "[FATAL] --seed needs a non-negative number, got '" << argv[a] << "'." << std::endl;
+        return 2;
+      }
+    } else if (arg == "--shard" && a + 1 < argc) {
+      try {
+        shard = ShardSpec::parse(argv[++a]);
+      } catch (const std::exception& e) {
+        std::cerr << "[FATAL] " << e.what() << std::endl;
+        return 2;
+      }
+    } else if (arg == "--out" && a + 1 < argc) {
+      outFile = argv[++a];
+    } else if (arg == "--runs" && a + 1 < argc) {
+      std::uint64_t runs = 0;
+      if (!parseNumber(argv[++a], 1, INT_MAX, runs)) {
+        std::cerr << "[FATAL] --runs needs a positive number of games, got '" << argv[a] << "'." << std::endl;
+        return 2;
+      }
+      batchRuns = static_cast<int>(runs);
+    } else if (arg == "--every-secret") {
+      everySecret = true;
+    } else if (arg == "--checkpoint-every" && a + 1 < argc) {
+      std::uint64_t interval = 0;
+      if (!parseNumber(argv[++a], 1, INT_MAX, interval)) {
+        std::cerr << "[FATAL] --checkpoint-every needs a positive number of seconds, got '" << argv[a] << "'." << std::endl;
+        return 2;
+      }
+      checkpoint.interval = std::chrono::seconds(interval);
+    } else if (arg == "--resume") {
+      checkpoint.resume = true;
+    } else if (arg == "--pattern-cache" && a + 1 < argc) {
+      std::uint64_t mib = 0;
+      if (!parseNumber(argv[++a], 1, SIZE_MAX >> 20, mib)) {
+        std::cerr << "[FATAL] --pattern-cache needs a positive size in MiB, got '" << argv[a] << "'." << std::endl;
+        return 2;
+      }
+      patternCacheMiB = static_cast<std::size_t>(mib);
+    } else if (arg == "--scratch" && a + 1 < argc) {
+      scratchFile = argv[++a];
+    } else if (arg.rfind("--", 0) == 0) {
+      std::cerr << "[FATAL] Unknown option or missing value: '" << arg << "'." << std::endl;
+      return 2;
+    } else {
+      wordListFile = arg;
+    }
+  }
+
+  // Large dictionaries: tiled entropy sweeps, bounded row cache, optional spill file
+  if (patternCacheMiB > 0 || !scratchFile.empty()) {
+    PatternTable::Options options;
+    if (patternCacheMiB > 0) options.memoryCap = patternCacheMiB << 20;
+    options.scratchFile = scratchFile;
+    DictionaryRegistry::instance().enablePatternTables(options);
+  }
+
+  // Default: the dictionary compiled into the binary. An optional word list file replaces it.
+  DictionaryRegistry::Handle dictionary;
+  try {
+    dictionary = DictionaryRegistry::instance().get(wordListFile.empty() ? DictionaryRegistry::EMBEDDED : wordListFile);
+  } catch (const std::exception& e) {
+    std::cerr << "[FATAL] " << e.what() << std::endl;
+    return 2;
+  }
+  const std::shared_ptr<const WordTable> wordTable = dictionary->words;
+
+  StrategyConfig strategy;
+  strategy.hardMode = hardMode;
+  strategy.patternTable = dictionary->patterns;
+
+  // Secrets come from the seed, so every process of a sharded run draws the same games
+  std::mt19937_64 rng(seed);
+  std::cout << "[INFO] Seed: " << seed << std::endl;
+
+  if (!outFile.empty()) {
+    // Batch run: play this process' shard of the games and write them for assignment_merge
+    try {
+      std::vector<int> gameSecrets;
+      if (everySecret) {
+        for (int secret = 0; secret < static_cast<int>(wordTable->size()); ++secret) gameSecrets.push_back(secret);
+      } else {
+        for (int g = 0; g < batchRuns; ++g) gameSecrets.push_back(WordleGame::chooseRandomSecret(*wordTable, rng));
+      }
+      std::vector<int> games;
+      std::vector<int> secrets;
+      for (int g = 0; g < static_cast<int>(gameSecrets.size()); ++g) {
+        if (!shard.owns(g)) continue;
+        games.push_back(g);
+        secrets.push_back(gameSecrets[g]);
+      }
+
+      // Long runs survive interruptions: <out>.ckpt is rewritten in the background, --resume continues from it
+      checkpoint.file = outFile + ".ckpt";
+      std::ifstream existing(checkpoint.file);
+      if (checkpoint.resume && existing) {
+        std::cout << "[INFO] Resuming from " << checkpoint.file << std::endl;
+      }
+      const std::vector<GameRecord> records = Simulation::playAll(wordTable, secrets, strategy, 0, nullptr, &checkpoint);
+      std::vector<ShardEntry> entries(records.size());
+      for (std::size_t i = 0; i < records.size(); ++i) {
+        entries[i].game = static_cast<std::uint32_t>(games[i]);
+        entries[i].record = records[i];
+      }
+      ShardHeader header;
+      header.shard = shard;
+      header.seed = seed;
+      header.games = static_cast<std::uint32_t>(gameSecrets.size());
+      header.words = static_cast<std::uint32_t>(wordTable->size());
+      header.dictionaryHash = ShardFile::dictionaryHash(*wordTable);
+      header.strategy = ShardFile::strategyFlags(strategy);
+      ShardFile::write(outFile, header, entries);
+      std::remove(checkpoint.file.c_str());
+      std::cout << "[INFO] Shard " << shard.index << "/" << shard.count << ": " << entries.size() << " of "
+                << gameSecrets.size() << " games written to " << outFile << std::endl;
+    } catch (const std::exception& e) {
+      std::cerr << "[FATAL] " << e.what() << std::endl;
+      return 2;
+    }
+    return 0;
+  }
+
   int mode = 0;
   std::cout << "[INFO] Welcome to the Wordle Solver!" << '\n';
   std::cout << "[INFO] Input mode" << '\n';
   std::cout << "[INFO] 0: Solution Simultaion" << '\n';
   std::cout << "[INFO] 1: NextGuess Helper" << '\n';
+  std::cout << "[INFO] 2: Adversary Game (Absurdle)" << '\n';
+  std::cout << "[INFO] 3: Worst-Case Analysis (every secret)" << '\n';
   std::cin >> mode;
   std::cout << "[INFO] Start Wordle-Solver..." << std::endl;
 
@@ -59,10 +215,11 @@ int main() {
   for (int g=0; g < runs; g++) {
     try {
       auto feedbackStrategy = std::make_unique<FeedbackStrategy>();
-      std::unique_ptr<WordleGame> game = std::make_unique<WordleGame>("C:/Code GIT/praktikuminfauto25wordlepart2-gruppe105/data/word-bank.csv");
+      std::unique_ptr<WordleGame> game = std::make_unique<WordleGame>(wordTable, WordleGame::chooseRandomSecret(*wordTable, rng));
       int maxTries = game->getMaxTries();
       std::string secret = game->getSecret();
       const auto solver = std::make_unique<WordleSolver>(std::move(game));
+      strategy.applyTo(*solver);
 
       // std::cout << "[DEBUG] Secret word is: " <<secret << std::endl;
 
@@ -133,18 +290,59 @@ int main() {
   std::cout << "[INFO] Game Fails: " << fails << std::endl;
   std::cout << "[INFO] 1-Tries: " << tries[0] << ", 2-Tries: " << tries[1] << ", 3-Tries: " << tries[2] << ", 4-Tries: " << tries[3] << ", 5-Tries: " << tries[4] << ", 6-Tries: " << tries[5] << std::endl;
   std::cout << "[INFO] 1-Tries: " << (static_cast<double> (tries[0])/runs) *100 << "%, 2-Tries: " << static_cast<double>(tries[1])/runs*100 << "%, 3-Tries: " << static_cast<double>(tries[2])/runs*100 << "%, 4-Tries: " << static_cast<double>(tries[3])/runs*100 << "%, 5-Tries: " << static_cast<double>(tries[4])/runs*100 << "%, 6-Tries: " << static_cast<double>(tries[5])/runs*100 << "%" << std::endl;
+  printPatternStats(strategy);
+
+  } else if (mode == 2) {
+    try {
+      const GameRecord record = Simulation::playAdversary(wordTable, strategy, AdversarialGame::Policy::MostDamaging);
+      for (std::size_t i = 0; i < record.path.size(); ++i) {
+        std::cout << "Attempt " + std::to_string(i + 1) + ": " + wordTable->wordAt(record.path[i]) << '\n';
+      }
+      if (record.solved) {
+        std::cout << "[INFO] Beat the adversary in " << record.tries << " attempts! The solution was: " << wordTable->wordAt(record.secret) << std::endl;
+      } else {
+        std::cout << "[INFO] The adversary won!" << std::endl;
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "[FATAL] " << e.what() << std::endl;
+      return 2;
+    }
 
-  }else {
+  } else if (mode == 3) {
+    try {
+      const WorstCaseReport report = Simulation::analyzeWorstCase(wordTable, strategy);
+      std::cout << "[INFO] Games: " << wordTable->size() << " (" << report.seconds << " s)" << std::endl;
+      std::cout << "[INFO] Distinct solver states: " << report.distinctStates << std::endl;
+      std::cout << "[INFO] Game Average Tries: " << report.averageTries << std::endl;
+      std::cout << "[INFO] Game Fails: " << report.fails << std::endl;
+      std::cout << "[INFO] Worst Case: " << report.maxTries << " tries (" << report.worstSecrets.size() << " secrets):";
+      for (const int secret : report.worstSecrets) {
+        std::cout << ' ' << wordTable->wordAt(secret);
+      }
+      std::cout << std::endl;
+      printPatternStats(strategy);
+    } catch (const std::exception& e) {
+      std::cerr << "[FATAL] " << e.what() << std::endl;
+      return 2;
+    }
+
+  } else {
     int i = 0;
 
     auto feedbackStrategy = std::make_unique<FeedbackStrategy>();
-    std::unique_ptr<WordleGame> game = std::make_unique<WordleGame>("C:/Code GIT/praktikuminfauto25wordlepart2-gruppe105/data/word-bank.csv");
+    std::unique_ptr<WordleGame> game = std::make_unique<WordleGame>(wordTable, WordleGame::chooseRandomSecret(*wordTable));
     const auto solver = std::make_unique<WordleSolver>(std::move(game));
+    strategy.applyTo(*solver);
+    solver->rankingSize = 5;
 
     while (true){
     try {
 
       std::string guess = solver->nextGuess();
+      // The chosen guess and its runners-up, from the same pass that picked it
+      if (!solver->getLastRanking().empty()) {
+        WordleSolver::printEntropyResults(solver->getLastRanking());
+      }
       std::cout << "Try: " + std::to_string(i + 1) + ": " + guess << '\n';
       std::cout << "[0: false] [1:correct Letter] [2: correct] , example would be: 00201 and end to finish" << '\n';
       std::string fdbkString;
@@ -0,0 +1,38 @@
+#include "../include/ShardFile.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: assignment_merge shard-0.bin shard-1.bin ...
+// Combines the shard files of one run and prints the summary of a Main simulation.
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: assignment_merge <shard file>..." << std::endl;
+    return 2;
+  }
+  const std::vector<std::string> files(argv + 1, argv + argc);
+
+  MergedResults merged;
+  try {
+    merged = ShardFile::merge(files);
+  } catch (const std::exception& e) {
+    std::cerr << "[FATAL] " << e.what() << std::endl;
+    return 2;
+  }
+
+  const int runs = merged.games;
+  const auto& tries = merged.tries;
+  std::cout << "[INFO] Shards: " << files.size() << std::endl;
+  if (merged.missing > 0 || merged.duplicates > 0) {
+    std::cout << "[WARN] Missing games: " << merged.missing << ", duplicate games: " << merged.duplicates << std::endl;
+  }
+  std::cout << "[INFO] Games: " << runs << std::endl;
+  std::cout << "[INFO] Game Average Tries: " << merged.averageTries << std::endl;
+  std::cout << "[INFO] Game Fails: " << merged.fails << std::endl;
+  std::cout << "[INFO] 1-Tries: " << tries[0] << ", 2-Tries: " << tries[1] << ", 3-Tries: " << tries[2] << ", 4-Tries: " << tries[3] << ", 5-Tries: " << tries[4] << ", 6-Tries: " << tries[5] << std::endl;
+  if (runs > 0) {
+    std::cout << "[INFO] 1-Tries: " << (static_cast<double> (tries[0])/runs) *100 << "%, 2-Tries: " << static_cast<double>(tries[1])/runs*100 << "%, 3-Tries: " << static_cast<double>(tries[2])/runs*100 << "%, 4-Tries: " << static_cast<double>(tries[3])/runs*100 << "%, 5-Tries: " << static_cast<double>(tries[4])/runs*100 << "%, 6-Tries: " << static_cast<double>(tries[5])/runs*100 << "%" << std::endl;
+  }
+  std::cout << "[INFO] Solver time: " << merged.gameSeconds << " s" << std::endl;
+  return 0;
+}
@@ -0,0 +1,183 @@
+#include "../include/PatternTable.h"
+#include "../include/WordleExceptions.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define WORDLE_HAS_MMAP 1
+#endif
+
+namespace {
+// Guesses whose histograms are filled while one candidate tile is hot
+constexpr std::size_t GUESS_BLOCK = 32;
+}
+
+PatternTable::PatternTable(std::shared_ptr<const WordTable> words, Options options)
+    : words(std::move(words)), options(std::move(options)) {
+  if (!this->words || this->words->empty()) {
+    throw WordListEmptyException();
+  }
+  const std::size_t rowBytes = this->words->size() * sizeof(Pattern);
+  capacityRows = std::max<std::size_t>(1, this->options.memoryCap / rowBytes);
+
+  if (!this->options.scratchFile.empty()) {
+#ifdef WORDLE_HAS_MMAP
+    scratchSize = rowBytes * this->words->size();
+    std::string path = this->options.scratchFile + ".XXXXXX";
+    scratchFd = ::mkstemp(path.data());
+    if (scratchFd >= 0) {
+      // The open descriptor keeps the file alive; no name is left behind, even after a crash
+      ::unlink(path.c_str());
+    }
+    // ftruncate leaves a sparse file: only spilled rows take disk space
+    if (scratchFd < 0 || ::ftruncate(scratchFd, static_cast<off_t>(scratchSize)) != 0) {
+      if (scratchFd >= 0) ::close(scratchFd);
+      throw std::runtime_error("[ERROR] Could not create a scratch file at '" + this->options.scratchFile + "'.");
+    }
+    void* mapping = ::mmap(nullptr, scratchSize, PROT_READ | PROT_WRITE, MAP_SHARED, scratchFd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(scratchFd);
+      throw std::runtime_error("[ERROR] Could not map the scratch file '" + this->options.scratchFile + "'.");
+    }
+    scratch = static_cast<Pattern*>(mapping);
+    spilled.assign(this->words->size(), false);
+#else
+    throw std::runtime_error("[ERROR] Scratch files need mmap, which this platform does not provide.");
+#endif
+  }
+}
+
+PatternTable::~PatternTable() {
+#ifdef WORDLE_HAS_MMAP
+  if (scratch != nullptr) {
+    ::munmap(scratch, scratchSize);
+  }
+  if (scratchFd >= 0) {
+    ::close(scratchFd);
+  }
+#endif
+}
+
+std::size_t PatternTable::tileWords() const {
+  return std::max<std::size_t>(64, options.tileBytes / sizeof(Word));
+}
+
+PatternTable::Row PatternTable::row(int guess) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = cache.find(guess);
+    if (it != cache.end()) {
+      lru.splice(lru.begin(), lru, it->second.second);
+      stats.hits++;
+      return it->second.first;
+    }
+    stats.misses++;
+  }
+
+  auto patterns = std::make_shared<std::vector<Pattern>>(words->size());
+  if (!readSpilled(guess, *patterns)) {
+    const Word guessWord = (*words)[guess];
+    const auto& all = words->getWords();
+    for (std::size_t s = 0; s < all.size(); ++s) {
+      (*patterns)[s] = FeedbackStrategy::calculatePattern(guessWord, all[s]);
+    }
+  }
+  Row result = std::move(patterns);
+  insertRow(guess, result);
+  return result;
+}
+
+std::vector<double> PatternTable::entropies(const std::vector<int>& guesses, const std::vector<int>& candidates) const {
+  std::vector<double> result(guesses.size(), 0.0);
+  if (candidates.empty()) return result;
+
+  // Gather the candidates once, so every tile is a contiguous run of packed words
+  std::vector<Word> solutions;
+  solutions.reserve(candidates.size());
+  for (const int candidate : candidates) {
+    solutions.push_back((*words)[candidate]);
+  }
+
+  const std::size_t tile = tileWords();
+  const double total = static_cast<double>(candidates.size());
+  std::vector<std::array<int, PATTERN_COUNT>> histograms(GUESS_BLOCK);
+
+  for (std::size_t blockBegin = 0; blockBegin < guesses.size(); blockBegin += GUESS_BLOCK) {
+    const std::size_t blockEnd = std::min(guesses.size(), blockBegin + GUESS_BLOCK);
+    for (auto& histogram : histograms) {
+      histogram.fill(0);
+    }
+    for (std::size_t begin = 0; begin < solutions.size(); begin += tile) {
+      const std::size_t end = std::min(solutions.size(), begin + tile);
+      for (std::size_t g = blockBegin; g < blockEnd; ++g) {
+        const Word guessWord = (*words)[guesses[g]];
+        auto& histogram = histograms[g - blockBegin];
+        for (std::size_t s = begin; s < end; ++s) {
+          ++histogram[FeedbackStrategy::calculatePattern(guessWord, solutions[s])];
+        }
+      }
+    }
+    for (std::size_t g = blockBegin; g < blockEnd; ++g) {
+      double entropy = 0.0;
+      for (const int count : histograms[g - blockBegin]) {
+        if (count == 0) continue;
+        const double p = count / total;
+        entropy -= p * std::log2(p);
+      }
+      result[g] = entropy;
+    }
+  }
+  return result;
+}
+
+PatternTable::Stats PatternTable::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats current = stats;
+  current.cachedRows = cache.size();
+  return current;
+}
+
+void PatternTable::insertRow(int guess, Row row) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (cache.find(guess) != cache.end()) return;
+  lru.push_front(guess);
+  cache.emplace(guess, std::make_pair(std::move(row), lru.begin()));
+
+  while (cache.size() > capacityRows) {
+    const int evicted = lru.back();
+    lru.pop_back();
+    const auto it = cache.find(evicted);
+    spill(evicted, *it->second.first);
+    cache.erase(it);
+  }
+}
+
+/**
+ * @brief Copies a spilled row back from the scratch file.
+ * @return False if there is no scratch file or the row was never spilled.
+ */
+bool PatternTable::readSpilled(int guess, std::vector<Pattern>& out) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (scratch == nullptr || !spilled[guess]) return false;
+  std::memcpy(out.data(), scratch + static_cast<std::size_t>(guess) * words->size(), words->size());
+  stats.spillReads++;
+  return true;
+}
+
+/**
+ * @brief Writes an evicted row to the scratch file (once). Caller holds the mutex.
+ */
+void PatternTable::spill(int guess, const std::vector<Pattern>& row) {
+  if (scratch == nullptr || spilled[guess]) return;
+  std::memcpy(scratch + static_cast<std::size_t>(guess) * words->size(), row.data(), row.size());
+  spilled[guess] = true;
+  stats.spillWrites++;
+}
@@ -0,0 +1,58 @@
+#include "../include/LogReplay.h"
+#include "../include/DictionaryRegistry.h"
+#include "../include/CommandLine.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: assignment_replay [--hard] [--threads N] <game log> <output file> [word list file]
+// Replays recorded games through the solver and writes one binary record per move (see LogReplay.h).
+namespace {
+constexpr std::uint64_t MAX_THREADS = 1024;
+}
+
+int main(int argc, char* argv[]) {
+  StrategyConfig strategy;
+  LogReplay::Options options;
+  std::vector<std::string> files;
+  for (int a = 1; a < argc; ++a) {
+    const std::string arg = argv[a];
+    if (arg == "--hard") {
+      strategy.hardMode = true;
+    } else if (arg == "--threads" && a + 1 < argc) {
+      // 0 = hardware concurrency
+      std::uint64_t threads = 0;
+      if (!parseNumber(argv[++a], 0, MAX_THREADS, threads)) {
+        std::cerr << "[FATAL] --threads needs a number from 0 to " << MAX_THREADS << ", got '" << argv[a] << "'." << std::endl;
+        return 2;
+      }
+      options.threads = static_cast<unsigned>(threads);
+    } else if (arg.rfind("--", 0) == 0) {
+      std::cerr << "[FATAL] Unknown option or missing value: '" << arg << "'." << std::endl;
+      return 2;
+    } else {
+      files.push_back(arg);
+    }
+  }
+  if (files.size() < 2 || files.size() > 3) {
+    std::cerr << "Usage: assignment_replay [--hard] [--threads N] <game log> <output file> [word list file]" << std::endl;
+    return 2;
+  }
+
+  try {
+    const std::shared_ptr<const WordTable> wordTable =
+        DictionaryRegistry::instance().get(files.size() == 3 ? files[2] : DictionaryRegistry::EMBEDDED)->words;
+    const LogReplay::Stats stats = LogReplay::run(files[0], files[1], wordTable, strategy, options);
+    std::cout << "[INFO] Games: " << stats.games << " (" << stats.seconds << " s)" << std::endl;
+    std::cout << "[INFO] Moves: " << stats.moves << std::endl;
+    std::cout << "[INFO] Moves matching the solver: " << stats.agreed << std::endl;
+    std::cout << "[INFO] Solver choices from the state cache: " << stats.cacheHits << std::endl;
+    std::cout << "[INFO] Inconsistent games: " << stats.inconsistent << std::endl;
+    std::cout << "[INFO] Unparsable lines: " << stats.unparsable << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "[FATAL] " << e.what() << std::endl;
+    return 2;
+  }
+  return 0;
+}
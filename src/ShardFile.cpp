@@ -0,0 +1,170 @@
+#include "../include/ShardFile.h"
+#include "../include/BinaryIO.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+namespace {
+constexpr char MAGIC[4] = {'W', 'R', 'D', 'S'};
+
+int indexBytes(std::uint32_t words) { return words < 65536 ? 2 : 4; }
+}
+
+ShardSpec ShardSpec::parse(const std::string& text) {
+  const std::size_t slash = text.find('/');
+  ShardSpec spec;
+  try {
+    if (slash == std::string::npos) throw std::invalid_argument(text);
+    std::size_t used = 0;
+    spec.index = std::stoi(text.substr(0, slash), &used);
+    if (used != slash) throw std::invalid_argument(text);
+    spec.count = std::stoi(text.substr(slash + 1), &used);
+    if (used != text.size() - slash - 1) throw std::invalid_argument(text);
+  } catch (const std::exception&) {
+    throw std::invalid_argument("[ERROR] Invalid shard '" + text + "', expected i/N.");
+  }
+  if (spec.count < 1 || spec.index < 0 || spec.index >= spec.count) {
+    throw std::invalid_argument("[ERROR] Invalid shard '" + text + "', expected 0 <= i < N.");
+  }
+  return spec;
+}
+
+/**
+ * @brief FNV-1a over the packed words, so shards played on different word lists do not merge.
+ */
+std::uint32_t ShardFile::dictionaryHash(const WordTable& words) {
+  std::uint32_t hash = 2166136261u;
+  for (const Word& word : words.getWords()) {
+    for (int i = 0; i < 4; ++i) {
+      hash ^= (word.letters >> (8 * i)) & 0xFF;
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
+
+std::uint8_t ShardFile::strategyFlags(const StrategyConfig& config) {
+  return static_cast<std::uint8_t>((config.hardMode ? 1 : 0) | (config.prefilter ? 2 : 0) | (config.lookahead ? 4 : 0));
+}
+
+void ShardFile::write(const std::string& file, const ShardHeader& header, const std::vector<ShardEntry>& entries) {
+  std::string out(MAGIC, sizeof(MAGIC));
+  putLittleEndian(out, VERSION, 4);
+  putLittleEndian(out, static_cast<std::uint32_t>(header.shard.index), 4);
+  putLittleEndian(out, static_cast<std::uint32_t>(header.shard.count), 4);
+  putLittleEndian(out, header.seed, 8);
+  putLittleEndian(out, header.games, 4);
+  putLittleEndian(out, header.words, 4);
+  putLittleEndian(out, header.dictionaryHash, 4);
+  putLittleEndian(out, header.strategy, 1);
+  putLittleEndian(out, entries.size(), 4);
+
+  const int width = indexBytes(header.words);
+  for (const ShardEntry& entry : entries) {
+    putLittleEndian(out, entry.game, 4);
+    putLittleEndian(out, static_cast<std::uint8_t>(entry.record.tries), 1);
+    putLittleEndian(out, static_cast<std::uint8_t>(entry.record.path.size()), 1);
+    putLittleEndian(out, entry.record.micros, 4);
+    putLittleEndian(out, static_cast<std::uint32_t>(entry.record.secret), width);
+    for (const int guess : entry.record.path) {
+      putLittleEndian(out, static_cast<std::uint32_t>(guess), width);
+    }
+  }
+
+  writeFileAtomically(file, out);
+}
+
+std::vector<ShardEntry> ShardFile::read(const std::string& file, ShardHeader& header) {
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[ERROR] Could not open the shard file '" + file + "'.");
+  }
+  const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  if (data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("[ERROR] '" + file + "' is not a shard file.");
+  }
+
+  LittleEndianReader reader(data, file);
+  reader.get(sizeof(MAGIC));
+  if (reader.get(4) != VERSION) {
+    throw std::runtime_error("[ERROR] The shard file '" + file + "' has an unsupported version.");
+  }
+  header.shard.index = static_cast<int>(reader.get(4));
+  header.shard.count = static_cast<int>(reader.get(4));
+  header.seed = reader.get(8);
+  header.games = static_cast<std::uint32_t>(reader.get(4));
+  header.words = static_cast<std::uint32_t>(reader.get(4));
+  header.dictionaryHash = static_cast<std::uint32_t>(reader.get(4));
+  header.strategy = static_cast<std::uint8_t>(reader.get(1));
+
+  const int width = indexBytes(header.words);
+  // Smallest entry: game, tries, path length, micros and the secret
+  std::vector<ShardEntry> entries(reader.getCount(4, 10 + width));
+  for (ShardEntry& entry : entries) {
+    entry.game = static_cast<std::uint32_t>(reader.get(4));
+    entry.record.tries = static_cast<int>(reader.get(1));
+    entry.record.path.resize(reader.get(1));
+    entry.record.micros = static_cast<std::uint32_t>(reader.get(4));
+    // Indices are compared unsigned, before the cast to int could make them negative
+    bool indicesValid = entry.game < header.games;
+    const std::uint64_t secret = reader.get(width);
+    indicesValid = indicesValid && secret < header.words;
+    entry.record.secret = static_cast<int>(secret);
+    for (int& guess : entry.record.path) {
+      const std::uint64_t index = reader.get(width);
+      indicesValid = indicesValid && index < header.words;
+      guess = static_cast<int>(index);
+    }
+    entry.record.solved = entry.record.tries <= Simulation::MAX_TRIES;
+    if (!entry.record.isConsistent() || !indicesValid) {
+      throw std::runtime_error("[ERROR] The shard file '" + file + "' is corrupt (invalid record of game " +
+                               std::to_string(entry.game) + ").");
+    }
+  }
+  if (!reader.done()) {
+    throw std::runtime_error("[ERROR] The shard file '" + file + "' has trailing data.");
+  }
+  return entries;
+}
+
+MergedResults ShardFile::merge(const std::vector<std::string>& files) {
+  MergedResults merged;
+  ShardHeader first;
+  std::unordered_set<std::uint32_t> seen;
+  double total = 0.0;
+
+  for (std::size_t f = 0; f < files.size(); ++f) {
+    ShardHeader header;
+    const std::vector<ShardEntry> entries = read(files[f], header);
+    if (f == 0) {
+      first = header;
+    } else if (header.seed != first.seed || header.games != first.games || header.words != first.words ||
+               header.dictionaryHash != first.dictionaryHash || header.strategy != first.strategy ||
+               header.shard.count != first.shard.count) {
+      throw std::runtime_error("[ERROR] The shard file '" + files[f] + "' belongs to a different run than '" +
+                               files[0] + "'.");
+    }
+
+    for (const ShardEntry& entry : entries) {
+      if (!seen.insert(entry.game).second) {
+        merged.duplicates++;
+        continue;
+      }
+      const GameRecord& record = entry.record;
+      if (record.solved) {
+        merged.tries[record.tries - 1]++;
+      } else {
+        merged.fails++;
+      }
+      total += record.tries;
+      merged.gameSeconds += record.micros / 1e6;
+    }
+  }
+
+  merged.games = static_cast<int>(seen.size());
+  merged.missing = static_cast<int>(first.games) - merged.games;
+  merged.averageTries = merged.games > 0 ? total / merged.games : 0.0;
+  return merged;
+}
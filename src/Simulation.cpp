@@ -0,0 +1,395 @@
+#include "../include/Simulation.h"
+#include "../include/Checkpoint.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+/**
+ * @brief Rebuilds the solver state of a history with the same updates playGame runs per turn.
+ * Only needed for states restored from a checkpoint, all others are forked from their parent.
+ */
+std::unique_ptr<WordleSolver> replay(const std::shared_ptr<const WordTable>& words, const StrategyConfig& config,
+                                     const LockstepState& group) {
+  // The solver only needs the game for the word table and try limit
+  auto solver = std::make_unique<WordleSolver>(std::make_unique<WordleGame>(words, 0));
+  config.applyTo(*solver);
+  for (std::size_t turn = 0; turn < group.path.size(); ++turn) {
+    solver->tries++;
+    solver->applyFeedback(words->wordAt(group.path[turn]), FeedbackStrategy::toFeedback(group.feedback[turn]));
+  }
+  return solver;
+}
+
+/**
+ * @brief Calls work(i) for every i < count on a pool of threads and rethrows the first exception.
+ */
+template <typename Work>
+void parallelFor(std::size_t count, unsigned threads, const Work& work) {
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < count; i = next++) {
+      try {
+        work(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) error = std::current_exception();
+        next = count;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  const std::size_t spawn = std::min<std::size_t>(threads, count);
+  for (std::size_t id = 1; id < spawn; ++id) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+}
+
+void StrategyConfig::applyTo(WordleSolver& solver) const {
+  solver.setHardMode(hardMode);
+  solver.prefilter.enabled = prefilter;
+  solver.lookahead.enabled = lookahead;
+  solver.lookahead.threads = lookaheadThreads;
+  solver.patternTable = patternTable;
+}
+
+bool GameRecord::isConsistent() const {
+  return tries >= 1 && tries <= Simulation::MAX_TRIES + 1 && path.size() <= static_cast<std::size_t>(tries);
+}
+
+GameRecord Simulation::playGame(const std::shared_ptr<const WordTable>& words, int secret, const StrategyConfig& config) {
+  const auto start = std::chrono::steady_clock::now();
+  WordleSolver solver(std::make_unique<WordleGame>(words, secret));
+  config.applyTo(solver);
+  const Word secretWord = (*words)[secret];
+
+  GameRecord record;
+  record.secret = secret;
+  record.tries = MAX_TRIES + 1;
+  for (int i = 0; i < MAX_TRIES; ++i) {
+    const std::string guess = solver.nextGuess();
+    const Word guessWord = packWord(guess);
+    record.path.push_back(words->indexOf(guessWord));
+
+    const Pattern pattern = FeedbackStrategy::calculatePattern(guessWord, secretWord);
+    solver.applyFeedback(guess, FeedbackStrategy::toFeedback(pattern));
+    if (pattern == ALL_CORRECT) {
+      record.tries = i + 1;
+      record.solved = true;
+      break;
+    }
+  }
+  record.micros = static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  return record;
+}
+
+GameRecord Simulation::playAdversary(const std::shared_ptr<const WordTable>& words, const StrategyConfig& config,
+                                     AdversarialGame::Policy policy) {
+  // The solver needs a game for the word table and try limit; its secret is never used
+  WordleSolver solver(std::make_unique<WordleGame>(words, 0));
+  config.applyTo(solver);
+  AdversarialGame adversary(words, policy);
+
+  GameRecord record;
+  record.tries = MAX_TRIES + 1;
+  for (int i = 0; i < MAX_TRIES; ++i) {
+    const std::string guess = solver.nextGuess();
+    const Word guessWord = packWord(guess);
+    record.path.push_back(words->indexOf(guessWord));
+
+    const Pattern pattern = adversary.respond(guessWord);
+    solver.applyFeedback(guess, FeedbackStrategy::toFeedback(pattern));
+    if (pattern == ALL_CORRECT) {
+      record.tries = i + 1;
+      record.solved = true;
+      break;
+    }
+  }
+  if (adversary.getCandidates().size() == 1 || record.solved) {
+    record.secret = adversary.getCandidates().front();
+  }
+  return record;
+}
+
+std::vector<GameRecord> Simulation::playAll(const std::shared_ptr<const WordTable>& words,
+                                            const std::vector<int>& secrets, const StrategyConfig& config,
+                                            unsigned threads, std::size_t* distinctStates,
+                                            const CheckpointOptions* checkpoint) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  // Parallelism is across states; the lookahead inside each state stays single threaded
+  StrategyConfig gameConfig = config;
+  if (threads > 1) {
+    gameConfig.lookaheadThreads = 1;
+  }
+
+  std::vector<GameRecord> records(secrets.size());
+  std::vector<double> seconds(secrets.size(), 0.0);
+  for (std::size_t i = 0; i < secrets.size(); ++i) {
+    records[i].secret = secrets[i];
+    records[i].tries = MAX_TRIES + 1;
+  }
+  std::vector<int> histogram(MAX_TRIES + 2, 0);
+  std::vector<LockstepState> groups;
+  std::uint64_t states = 0;
+
+  std::unique_ptr<CheckpointWriter> writer;
+  LockstepSnapshot restored;
+  // Checkpoints are built incrementally: finished records never change, so a snapshot only
+  // copies the games finished since the previous one
+  std::vector<int> finishOrder;           // finished games in commit order
+  std::vector<int> savedFinished;         // prefix of finishOrder already in savedRecords
+  std::vector<GameRecord> savedRecords;
+  bool snapshotting = false;              // one snapshot is built at a time
+  const bool checkpoints = checkpoint != nullptr && !checkpoint->file.empty();
+  const std::uint64_t runId = checkpoints ? Checkpoint::runId(*words, secrets, config) : 0;
+  if (checkpoints && checkpoint->resume && Checkpoint::read(checkpoint->file, restored)) {
+    if (restored.runId != runId) {
+      throw std::runtime_error("[ERROR] The checkpoint '" + checkpoint->file + "' belongs to a different run.");
+    }
+    // A matching run id does not protect against a damaged file: every game must be in exactly one
+    // place and every guess must be a word of the table, before anything indexes with them
+    const auto corrupt = [&]() {
+      return std::runtime_error("[ERROR] The checkpoint '" + checkpoint->file + "' is corrupt.");
+    };
+    std::vector<char> claimed(secrets.size(), 0);
+    auto claim = [&](int position) {
+      if (position < 0 || position >= static_cast<int>(secrets.size()) || claimed[position]) throw corrupt();
+      claimed[position] = 1;
+    };
+    auto checkPath = [&](const std::vector<int>& path) {
+      for (const int guess : path) {
+        if (guess < 0 || guess >= static_cast<int>(words->size())) throw corrupt();
+      }
+    };
+    for (std::size_t i = 0; i < restored.finished.size(); ++i) {
+      claim(restored.finished[i]);
+      if (restored.records[i].secret != secrets[restored.finished[i]]) throw corrupt();
+      checkPath(restored.records[i].path);
+    }
+    for (const LockstepState& state : restored.pending) {
+      for (const int position : state.members) {
+        claim(position);
+      }
+      checkPath(state.path);
+    }
+    savedFinished = restored.finished;
+    savedRecords = restored.records;
+    finishOrder = restored.finished;
+    for (std::size_t i = 0; i < restored.finished.size(); ++i) {
+      records[restored.finished[i]] = std::move(restored.records[i]);
+    }
+    histogram = restored.histogram;
+    groups = std::move(restored.pending);
+    states = restored.states;
+  } else if (!secrets.empty()) {
+    groups.emplace_back();
+    groups.back().members.resize(secrets.size());
+    std::iota(groups.back().members.begin(), groups.back().members.end(), 0);
+  }
+  if (checkpoints) {
+    writer = std::make_unique<CheckpointWriter>(checkpoint->file);
+  }
+  std::uint64_t sequence = restored.sequence;
+  auto lastCheckpoint = std::chrono::steady_clock::now();
+
+  // Called with the commit lock held: counters plus the games finished since the last checkpoint
+  auto startSnapshot = [&]() {
+    LockstepSnapshot snapshot;
+    snapshot.sequence = ++sequence;
+    snapshot.runId = runId;
+    snapshot.states = states;
+    snapshot.histogram = histogram;
+    snapshot.finished.assign(finishOrder.begin() + static_cast<std::ptrdiff_t>(savedFinished.size()), finishOrder.end());
+    return snapshot;
+  };
+
+  // Called without the lock, so workers keep committing meanwhile. Safe because records of finished
+  // games, the states of a round and the children of a done state are not written again.
+  auto completeSnapshot = [&](LockstepSnapshot& snapshot, const std::vector<LockstepState>& round,
+                              const std::vector<char>& done, const std::vector<std::vector<LockstepState>>& children) {
+    for (const int position : snapshot.finished) {
+      savedFinished.push_back(position);
+      savedRecords.push_back(records[position]);
+    }
+    snapshot.finished = savedFinished;
+    snapshot.records = savedRecords;
+    for (std::size_t g = 0; g < round.size(); ++g) {
+      if (done[g]) {
+        snapshot.pending.insert(snapshot.pending.end(), children[g].begin(), children[g].end());
+      } else {
+        snapshot.pending.push_back(round[g]);
+      }
+    }
+  };
+
+  // A state's turn is the length of its history; after a resume, states of two turns can share a round
+  while (!groups.empty()) {
+    std::vector<std::vector<LockstepState>> children(groups.size());
+    std::vector<char> done(groups.size(), 0);
+    std::mutex commitMutex;
+    parallelFor(groups.size(), threads, [&](std::size_t g) {
+      const LockstepState& group = groups[g];
+      const int turn = static_cast<int>(group.path.size());
+      const auto start = std::chrono::steady_clock::now();
+      WordleSolver solver = group.solver ? group.solver->fork() : std::move(*replay(words, gameConfig, group));
+      const std::string guessText = solver.nextGuess();
+      const int guess = words->indexOf(packWord(guessText));
+      const Word guessWord = (*words)[guess];
+
+      // Gather the secrets of the state into one contiguous block and score it in a single pass
+      const std::size_t size = group.members.size();
+      std::vector<Word> block(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        block[i] = (*words)[secrets[group.members[i]]];
+      }
+      std::vector<Pattern> patterns(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        patterns[i] = FeedbackStrategy::calculatePattern(guessWord, block[i]);
+      }
+
+      // Counting sort by pattern: one child state per pattern, members stay in order
+      std::array<int, PATTERN_COUNT + 1> begin{};
+      for (const Pattern pattern : patterns) {
+        begin[pattern + 1]++;
+      }
+      std::partial_sum(begin.begin(), begin.end(), begin.begin());
+      std::vector<int> sorted(size);
+      std::array<int, PATTERN_COUNT + 1> fill = begin;
+      for (std::size_t i = 0; i < size; ++i) {
+        sorted[fill[patterns[i]]++] = group.members[i];
+      }
+
+      std::vector<LockstepState> next;
+      std::vector<std::pair<int, Pattern>> ended; // member, final pattern
+      for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+        if (begin[pattern] == begin[pattern + 1]) continue;
+        const auto first = sorted.begin() + begin[pattern];
+        const auto last = sorted.begin() + begin[pattern + 1];
+        if (pattern == ALL_CORRECT || turn + 1 == MAX_TRIES) {
+          for (auto member = first; member != last; ++member) {
+            ended.emplace_back(*member, static_cast<Pattern>(pattern));
+          }
+          continue;
+        }
+        LockstepState child;
+        child.path = group.path;
+        child.path.push_back(guess);
+        child.feedback = group.feedback;
+        child.feedback.push_back(static_cast<Pattern>(pattern));
+        child.members.assign(first, last);
+        // O(1) fork, only the candidate sets the feedback narrows are copied
+        auto childSolver = std::make_shared<WordleSolver>(solver.fork());
+        childSolver->applyFeedback(guessText, FeedbackStrategy::toFeedback(static_cast<Pattern>(pattern)));
+        child.solver = std::move(childSolver);
+        next.push_back(std::move(child));
+      }
+
+      // The state's time, forks included, is split evenly across its games
+      const double share = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / size;
+      for (const int member : group.members) {
+        seconds[member] += share;
+      }
+
+      // Commit the state as a whole, so a snapshot never sees half of it
+      std::unique_lock<std::mutex> lock(commitMutex);
+      for (const auto& [member, pattern] : ended) {
+        GameRecord& record = records[member];
+        record.path = group.path;
+        record.path.push_back(guess);
+        if (pattern == ALL_CORRECT) {
+          record.tries = turn + 1;
+          record.solved = true;
+        }
+        record.micros = static_cast<std::uint32_t>(seconds[member] * 1e6);
+        histogram[record.tries]++;
+        finishOrder.push_back(member);
+      }
+      children[g] = std::move(next);
+      done[g] = 1;
+      states++;
+
+      const auto now = std::chrono::steady_clock::now();
+      if (writer && !snapshotting && now - lastCheckpoint >= checkpoint->interval) {
+        lastCheckpoint = now;
+        snapshotting = true;
+        LockstepSnapshot snapshot = startSnapshot();
+        const std::vector<char> doneNow = done;
+        lock.unlock();
+        completeSnapshot(snapshot, groups, doneNow, children);
+        writer->submit(std::move(snapshot));
+        lock.lock();
+        snapshotting = false;
+      }
+    });
+
+    groups.clear();
+    for (auto& group : children) {
+      std::move(group.begin(), group.end(), std::back_inserter(groups));
+    }
+  }
+
+  if (writer) {
+    // Final checkpoint: a crash before the caller stores the results resumes instantly
+    LockstepSnapshot snapshot = startSnapshot();
+    completeSnapshot(snapshot, {}, {}, {});
+    writer->submit(std::move(snapshot));
+    writer->finish();
+  }
+  if (distinctStates != nullptr) {
+    *distinctStates = static_cast<std::size_t>(states);
+  }
+  return records;
+}
+
+WorstCaseReport Simulation::analyzeWorstCase(const std::shared_ptr<const WordTable>& words,
+                                             const StrategyConfig& config, unsigned threads) {
+  const auto start = std::chrono::steady_clock::now();
+  WorstCaseReport report;
+
+  const int secrets = static_cast<int>(words->size());
+  std::vector<int> all(secrets);
+  std::iota(all.begin(), all.end(), 0);
+  std::vector<int> tries(secrets, 0);
+  for (const GameRecord& record : playAll(words, all, config, threads, &report.distinctStates)) {
+    tries[record.secret] = record.tries;
+  }
+
+  report.histogram.assign(MAX_TRIES + 2, 0);
+  double total = 0.0;
+  for (int secret = 0; secret < secrets; ++secret) {
+    report.histogram[tries[secret]]++;
+    total += tries[secret];
+    if (tries[secret] > report.maxTries) {
+      report.maxTries = tries[secret];
+      report.worstSecrets.clear();
+    }
+    if (tries[secret] == report.maxTries) {
+      report.worstSecrets.push_back(secret);
+    }
+  }
+  report.fails = report.histogram[MAX_TRIES + 1];
+  report.averageTries = secrets > 0 ? total / secrets : 0.0;
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return report;
+}
@@ -0,0 +1,37 @@
+#include "../include/Word.h"
+#include "../include/WordleExceptions.h"
+#include <cctype>
+#include <string>
+
+/**
+ * @brief Packs a word string (upper or lower case) into a Word.
+ * @param word The word to pack.
+ * @return The packed word.
+ */
+Word packWord(const std::string& word) {
+  if (word.size() != WORD_LENGTH) {
+    throw NotAFiveLetterWordException(word);
+  }
+  std::uint32_t letters = 0;
+  for (const char ch : word) {
+    const int c = std::tolower(static_cast<unsigned char>(ch));
+    if (c < 'a' || c > 'z') {
+      throw NotAValidWordException(word);
+    }
+    letters = letters << 5 | static_cast<std::uint32_t>(c - 'a');
+  }
+  return makeWord(letters);
+}
+
+/**
+ * @brief Converts a packed word back into its lowercase string.
+ * @param word The packed word.
+ * @return The lowercase word.
+ */
+std::string unpackWord(Word word) {
+  std::string s(WORD_LENGTH, ' ');
+  for (int i = 0; i < WORD_LENGTH; ++i) {
+    s[i] = static_cast<char>('a' + word.letterAt(i));
+  }
+  return s;
+}
@@ -0,0 +1,72 @@
+#include "../include/WordTable.h"
+#include "EmbeddedDictionary.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Packs a list of word strings into a sorted table.
+ * @param wordList The words, in any case and order. Duplicates are removed.
+ * @throws NotAFiveLetterWordException / NotAValidWordException for malformed entries.
+ */
+WordTable::WordTable(const std::vector<std::string>& wordList) {
+  words.reserve(wordList.size());
+  for (const auto& word : wordList) {
+    words.push_back(packWord(word));
+  }
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+  buildIndexes();
+}
+
+/**
+ * @brief Wraps already packed words; they are sorted and de-duplicated like string input.
+ */
+WordTable::WordTable(std::vector<Word> packedWords) : words(std::move(packedWords)) {
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+  buildIndexes();
+}
+
+std::shared_ptr<const WordTable> WordTable::embedded() {
+  // Already sorted and unique, so this is a plain copy out of .rodata
+  static const auto table = std::make_shared<const WordTable>(
+      std::vector<Word>(EMBEDDED_WORDS.begin(), EMBEDDED_WORDS.end()));
+  return table;
+}
+
+void WordTable::buildIndexes() {
+  counts.resize(words.size());
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    counts[i] = letterCountsOf(words[i]);
+    const int index = static_cast<int>(i);
+    for (int pos = 0; pos < WORD_LENGTH; ++pos) {
+      positionIndex[pos][words[i].letterAt(pos)].push_back(index);
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+      for (int k = 1; k <= letterCount(counts[i], letter); ++k) {
+        countIndex[letter][k - 1].push_back(index);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Binary search for a packed word.
+ * @return The index of the word, or -1 if it is not in the table.
+ */
+int WordTable::indexOf(Word word) const {
+  const auto it = std::lower_bound(words.begin(), words.end(), word);
+  if (it == words.end() || *it != word) return -1;
+  return static_cast<int>(it - words.begin());
+}
+
+/**
+ * @brief Looks up a word string; returns -1 for unknown or malformed words.
+ */
+int WordTable::indexOf(const std::string& word) const {
+  try {
+    return indexOf(packWord(word));
+  } catch (const std::runtime_error&) {
+    return -1;
+  }
+}
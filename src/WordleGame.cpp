@@ -1,17 +1,43 @@
 #include "../include/WordleGame.h"
+#include "../include/DictionaryRegistry.h"
 #include <algorithm>
 #include <cctype>
 #include <fstream>
 #include <memory>
 #include <random>
+#include <stdexcept>
 
+/**
+ * @brief Starts a game on the dictionary compiled into the binary (no file I/O).
+ */
+WordleGame::WordleGame() : WordleGame(WordTable::embedded(), chooseRandomSecret(*WordTable::embedded())) {}
+
+/**
+ * @brief Starts a game on a word list file. The list is loaded once per process through the
+ * DictionaryRegistry, so every game on the same file shares one table.
+ */
 WordleGame::WordleGame(const std::string& wordListFile) {
-  wordList = readWordList(wordListFile);
-  if (wordList.empty()) {
+  wordTable = DictionaryRegistry::instance().get(wordListFile)->words;
+  secret = chooseRandomSecret(*wordTable);
+  tries = 0;
+  feedbackStrategy = std::make_unique<FeedbackStrategy>();
+}
+
+/**
+ * @brief Starts a game on an already loaded word table with a fixed secret.
+ * @param words The shared word table.
+ * @param secretIndex Index of the secret inside the table.
+ * @throws WordListEmptyException if the table is empty.
+ * @throws std::out_of_range if the secret index is not inside the table.
+ */
+WordleGame::WordleGame(std::shared_ptr<const WordTable> words, int secretIndex)
+    : wordTable(std::move(words)), secret(secretIndex), tries(0) {
+  if (!wordTable || wordTable->empty()) {
     throw WordListEmptyException();
   }
-  secret = chooseRandomSecret(wordList);
-  tries = 0;
+  if (secretIndex < 0 || secretIndex >= static_cast<int>(wordTable->size())) {
+    throw std::out_of_range("[ERROR] Secret index is outside of the word list!");
+  }
   feedbackStrategy = std::make_unique<FeedbackStrategy>();
 }
 
@@ -20,14 +46,12 @@ WordleGame::WordleGame(const std::string& wordListFile) {
  * @brief Evaluates a guess and returns the feedback.
  * @param word The guessed word.
  * @return A vector of Feedback enums for each letter.
- * @throws std::invalid_argument if the guess has the wrong length.
+ * @throws NotAFiveLetterWordException if the guess has the wrong length.
  */
 std::vector<Feedback> WordleGame::guess(const std::string& word) {
-    if (word.length() != secret.length()) {
-        throw NotAFiveLetterWordException(word);
-    }
+    const Word packed = packWord(word);
     tries++;
-    return feedbackStrategy->calculateFeedback(word, secret);
+    return FeedbackStrategy::toFeedback(feedbackStrategy->calculatePattern(packed, (*wordTable)[secret]));
 }
 
 /**
@@ -54,7 +78,7 @@ int WordleGame::getMaxTries() const { return maxTries; }
 /**
  * @brief Returns the length of the secret word.
  */
-int WordleGame::getWordLength() const { return static_cast<int>(secret.size()); }
+int WordleGame::getWordLength() const { return WORD_LENGTH; }
 
 /**
  * @brief Reads a word list from a file.
@@ -73,17 +97,32 @@ std::vector<std::string> WordleGame::readWordList(const std::string& filename) {
 }
 
 /**
- * @brief Selects a random secret word from a word list.
- * @param wordList The list of possible words.
- * @return A randomly chosen word.
- * @throws std::invalid_argument if the word list is empty.
+ * @brief Selects a random secret word from a word table.
+ * @param wordTable The table of possible words.
+ * @return The index of a randomly chosen word.
+ * @throws WordListEmptyException if the word table is empty.
  */
-std::string WordleGame::chooseRandomSecret(const std::vector<std::string>& wordList) {
-    if (wordList.empty()) {
+int WordleGame::chooseRandomSecret(const WordTable& wordTable) {
+    if (wordTable.empty()) {
         throw WordListEmptyException();
     }
     std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, wordList.size() - 1);
-    return wordList[dis(gen)];
+    std::mt19937_64 gen(rd());
+    return chooseRandomSecret(wordTable, gen);
+}
+
+/**
+ * @brief Selects a secret word with a caller-owned generator, so a seed reproduces the secrets.
+ * mt19937_64 is fully specified and the modulo avoids the library-specific distributions,
+ * so every machine draws the same sequence for the same seed.
+ * @param wordTable The table of possible words.
+ * @param rng The generator to draw from.
+ * @return The index of the chosen word.
+ * @throws WordListEmptyException if the word table is empty.
+ */
+int WordleGame::chooseRandomSecret(const WordTable& wordTable, std::mt19937_64& rng) {
+    if (wordTable.empty()) {
+        throw WordListEmptyException();
+    }
+    return static_cast<int>(rng() % wordTable.size());
 }
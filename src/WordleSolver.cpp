@@ -1,32 +1,45 @@
 #include "../include/WordleSolver.h"
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <random>
 // #include <limits>
 #include <sstream>
 #include <stdexcept>
-#include <unordered_map>
+#include <bitset>
 #include <array>
 
 #include "WordleGame.h"
 #include "FeedbackStrategy.h"
 
 WordleSolver::WordleSolver(std::unique_ptr<WordleGame> m_game) {
-    if (m_game->wordList.empty()) {
+    if (!m_game->getWordTable() || m_game->getWordTable()->empty()) {
         throw WordListEmptyException();
     }
-    m_feedbackStrategy = std::make_unique<FeedbackStrategy>();
-    allWords = m_game->wordList;
-    for (auto& word : allWords) {
-      std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+    m_feedbackStrategy = std::make_shared<FeedbackStrategy>();
+    allWords = m_game->getWordTable();
+    std::vector<int>& guesses = allGuesses.mutate();
+    guesses.resize(allWords->size());
+    for (int i = 0; i < static_cast<int>(guesses.size()); ++i) {
+      guesses[i] = i;
     }
-    possibleWords = allWords;
+    possibleWords = allGuesses;
+    legalGuesses = allGuesses;
     game = std::move(m_game);
     // -1: no information, maxLetters[2] == 2 -> letter c can not have more then 2 letters
     maxLetters.fill(-1);
 }
 
-std::vector<Feedback> WordleSolver::getStoredFeedback(int attempt) const {
+WordleSolver WordleSolver::fork() const {
+  WordleSolver child(*this);
+  // The memo is not thread safe across searches, a fork may run on another thread
+  child.lookaheadSearch.reset();
+  return child;
+}
+
+Pattern WordleSolver::getStoredFeedback(int attempt) const {
   if (attempt < 0 || attempt >= storedFeedback.size()) {
     throw std::out_of_range("[ERROR] Invalid attempt number when accessing storedFeedback!");
   }
@@ -38,40 +51,80 @@ std::vector<Feedback> WordleSolver::getStoredFeedback(int attempt) const {
  * @param feedback
  */
 void WordleSolver::updateFeedback(const std::vector<Feedback>& feedback) {
-  storedFeedback.push_back(feedback);
+  storedFeedback.push_back(FeedbackStrategy::toPattern(feedback));
   //std::cout << "[DEBUG] Tries inside: " << tries << ", Feedback("<< tries <<"): " << feedbackToString(storedFeedback[tries]) << '\n';
 }
 
+/**
+ * @brief Runs every update of one turn in the order Main uses: store the feedback, update the
+ * absent letters and letter limits and, unless the game is won, filter the possible words.
+ * @param guess The guessed word.
+ * @param feedback The feedback for the guess.
+ */
+void WordleSolver::applyFeedback(const std::string& guess, const std::vector<Feedback>& feedback) {
+  updateFeedback(feedback);
+  addAbsentLetters(guess, feedback);
+  updateMaxLetters(guess, feedback);
+  if (!WordleGame::isWon(feedback)) {
+    updatePossibleWords(guess, feedback);
+  }
+}
+
 
 /**
  * @brief Calculates the Shannon entropy for a given guess word based on the current possible solutions.
  * The formula used is: H(X) = -Σ p(x) * log2(p(x)), where p(x) is the probability of each pattern.
  * The probability p(x) is calculated as the count of each pattern divided by the total number of possible words.
- * @param guess The guess word.
- * @param possibleWords The current set of possible solution words.
+ * @param guess Index of the guess word.
+ * @param candidates Indices of the current set of possible solution words.
  * @return The expected entropy value.
  */
-double WordleSolver::calculateEntropy(const std::string& guess, const std::vector<std::string>& possibleWords) const {
+double WordleSolver::calculateEntropy(int guess, const std::vector<int>& candidates) const {
+  return scoreGuess(guess, candidates).entropy;
+}
+
+/**
+ * @brief Entropy plus the bucket statistics of rankGuesses, from one pattern histogram.
+ * @param guess Index of the guess word.
+ * @param candidates Indices of the current set of possible solution words.
+ */
+WordleSolver::GuessScore WordleSolver::scoreGuess(int guess, const std::vector<int>& candidates) const {
+  GuessScore score;
+  score.guess = guess;
   // Should never happen without getting flagged before
-  if (possibleWords.empty()) return 0.0;
+  if (candidates.empty()) return score;
 
-  double entropy = 0;
-  const double total = static_cast<double>(possibleWords.size());
-  std::unordered_map<std::string, std::size_t> patternCount;
+  const double total = static_cast<double>(candidates.size());
+  // Patterns are 0..242, so a flat histogram replaces the old string map
+  std::array<int, PATTERN_COUNT> patternCount{};
 
-  for (const auto &word : possibleWords) {
-    std::string pat = feedbackToString(feedbackPattern(guess, word));
-    ++patternCount[pat];
+  if (patternTable && patternTable->rowsPayOff(candidates.size())) {
+    // Guesses that get scored again (refinement, audits, later turns) come from the row cache
+    const PatternTable::Row row = patternTable->row(guess);
+    for (const int word : candidates) {
+      ++patternCount[(*row)[word]];
+    }
+  } else {
+    const Word guessWord = (*allWords)[guess];
+    for (const int word : candidates) {
+      ++patternCount[FeedbackStrategy::calculatePattern(guessWord, (*allWords)[word])];
+    }
   }
 
   // 2:
-  for (const auto& [pat, count] : patternCount)
+  double squares = 0.0;
+  for (const int count : patternCount)
   {
+    if (count == 0) continue;
     double p = count / total;
-    entropy -= p * std::log2(p);
+    score.entropy -= p * std::log2(p);
+    // A bucket of size c is hit with probability c / n and leaves c candidates
+    squares += static_cast<double>(count) * count;
+    score.worstBucket = std::max(score.worstBucket, count);
   }
+  score.expectedRemaining = squares / total;
 
-  return entropy;
+  return score;
 }
 
 
@@ -80,17 +133,14 @@ double WordleSolver::calculateEntropy(const std::string& guess, const std::vecto
  * @brief Get LetterFrequency of a word. Only adds letters that match the given Feedback
  * @param fdbk The feedback that needs to be given for the letter for it to count into its frequency: so if you only want to count Present letter Frequency
  */
-std::array<int, 26> WordleSolver::getLetterFrequency(const std::string& word, const std::vector<Feedback>& feedback, Feedback fdbk) {
+std::array<int, 26> WordleSolver::getLetterFrequency(Word word, const std::array<Feedback, WORD_LENGTH>& feedback, Feedback fdbk) {
   std::array<int, 26> letterFrequency;
   letterFrequency.fill(0);
 
   for (int i = 0; i < 5; ++i) {
-    char g = std::tolower(word[i]);
     if (feedback[i] == fdbk) {
-      if (g >= 'a' && g <= 'z') {
-        // Works because lowercase asci to index is 97 to 128 so difference between lowest 'a' is all we need
-        letterFrequency[g - 'a']++;
-      }
+      // Packed letters already are 0..25, no case conversion needed
+      letterFrequency[word.letterAt(i)]++;
     }
   }
   return letterFrequency;
@@ -118,34 +168,425 @@ std::string WordleSolver::nextGuess() {
 
   // precomputed: https://www.youtube.com/watch?v=fRed0Xmc2Wg
   // Check out README.txt for more info
+  lastRanking.clear();
   if (tries == 0) {
     tries++;
     return "slate";
   }
 
-  std::string nextGuess;
-  std::vector<std::string> topGuesses;
-  std::unordered_map<std::string, double> entropyMap;
-  double entropy;
+  int nextGuess = -1;
   double maxEntropy = -1.0;
 
-  for (const std::string& word : possibleWords) {
-    entropy = calculateEntropy(word, possibleWords);
-    entropyMap[word] = entropy;
+  // Late game: search for the guess that most likely solves within the remaining tries.
+  // This replaces the probe word special cases for these sets.
+  if (lookahead.enabled && possibleWords.size() <= lookahead.maxCandidates) {
+    if (!lookaheadSearch) {
+      lookaheadSearch = std::make_unique<LookaheadSearch>(allWords, lookahead.threads);
+    }
+    const std::vector<int>& guesses = allowedGuesses();
+    // Second ply only needs good splitters: the candidates plus the prefilter shortlist
+    std::vector<int> followUps = prefilterGuesses(guesses);
+    followUps.insert(followUps.end(), possibleWords.begin(), possibleWords.end());
+    std::sort(followUps.begin(), followUps.end());
+    followUps.erase(std::unique(followUps.begin(), followUps.end()), followUps.end());
+    nextGuess = lookaheadSearch->search(possibleWords, guesses, followUps, game->getMaxTries() - tries).guess;
+    if (rankingSize > 0) {
+      lastRanking.push_back(toRanked(scoreGuess(nextGuess, possibleWords)));
+    }
+    tries++;
+    return allWords->wordAt(nextGuess);
+  }
+
+  // Hard mode scores the legal guesses, otherwise the candidates themselves
+  const std::vector<int>& guesses = hardMode ? legalGuesses : possibleWords;
+
+  if (prefilter.enabled && guesses.size() >= prefilter.minCandidates) {
+    // Stage 1: O(n) heuristic shortlist, stage 2: exact entropy only for the shortlist
+    const std::vector<int> shortlist = prefilterGuesses(guesses);
+    nextGuess = pickEntropyGuess(shortlist, maxEntropy);
+    prefilterStats.turns++;
+    prefilterStats.shortlisted += shortlist.size();
+
+    if (prefilter.auditEvery != 0 && prefilterStats.turns % prefilter.auditEvery == 0) {
+      double fullMaxEntropy = -1.0;
+      bestEntropyGuess(guesses, fullMaxEntropy);
+      prefilterStats.audited++;
+      if (fullMaxEntropy > maxEntropy + 1e-9) {
+        prefilterStats.missed++;
+      }
+    }
+  } else {
+    nextGuess = pickEntropyGuess(guesses, maxEntropy);
+  }
+
+  const int probe = applyProbeWord(nextGuess);
+  if (probe != nextGuess && rankingSize > 0) {
+    // The probe word is played instead, so it heads the ranking
+    lastRanking.insert(lastRanking.begin(), toRanked(scoreGuess(probe, possibleWords)));
+    lastRanking.resize(std::min(lastRanking.size(), rankingSize));
+  }
+  nextGuess = probe;
+
+  tries++;
+  return allWords->wordAt(nextGuess);
+}
+
+/**
+ * @brief Exact entropy scan over a set of guesses.
+ * @param guesses Indices of the guesses to score, in dictionary order.
+ * @param maxEntropy Receives the entropy of the returned guess.
+ * @return Index of the guess with the highest entropy; the first one wins ties.
+ */
+int WordleSolver::bestEntropyGuess(const std::vector<int>& guesses, double& maxEntropy) const {
+  const std::vector<GuessScore> best = topGuesses(guesses, 1);
+  maxEntropy = best.empty() ? -1.0 : best.front().entropy;
+  return best.empty() ? -1 : best.front().guess;
+}
+
+/**
+ * @brief The k highest-entropy guesses, best first, from one pass with a bounded heap.
+ * Ties go to the lower index, i.e. the first maximum in dictionary order.
+ */
+std::vector<WordleSolver::GuessScore> WordleSolver::topGuesses(const std::vector<int>& guesses, std::size_t k) const {
+  // Used as heap "less": the front of the heap is the worst kept guess
+  auto better = [](const GuessScore& a, const GuessScore& b) {
+    return a.entropy > b.entropy || (a.entropy == b.entropy && a.guess < b.guess);
+  };
+  std::vector<GuessScore> heap;
+  heap.reserve(k + 1);
+  auto offer = [&](const GuessScore& score) {
+    if (heap.size() < k) {
+      heap.push_back(score);
+      std::push_heap(heap.begin(), heap.end(), better);
+    } else if (k > 0 && better(score, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), better);
+      heap.back() = score;
+      std::push_heap(heap.begin(), heap.end(), better);
+    }
+  };
+
+  // Large candidate sets: cache-blocked sweep. Smaller ones fall through to scoreGuess,
+  // which uses the cached pattern rows while the candidates are a large part of the table.
+  if (patternTable && possibleWords.size() > patternTable->getTileWords()) {
+    const std::vector<double> entropies = patternTable->entropies(guesses, possibleWords);
+    for (std::size_t i = 0; i < guesses.size(); ++i) {
+      GuessScore score;
+      score.guess = guesses[i];
+      score.entropy = entropies[i];
+      offer(score);
+    }
+    // The sweep only yields entropies, the k kept guesses get their bucket statistics here
+    for (GuessScore& score : heap) {
+      score = scoreGuess(score.guess, possibleWords);
+    }
+  } else {
+    for (const int word : guesses) {
+      offer(scoreGuess(word, possibleWords));
+    }
+  }
+
+  std::sort_heap(heap.begin(), heap.end(), better);
+  return heap;
+}
+
+/**
+ * @brief Entropy stage of nextGuess(): one bounded-heap pass that yields the best guess and,
+ * with rankingSize > 0, the runners-up for getLastRanking().
+ */
+int WordleSolver::pickEntropyGuess(const std::vector<int>& guesses, double& maxEntropy) {
+  const std::vector<GuessScore> best = topGuesses(guesses, std::max<std::size_t>(1, rankingSize));
+  if (rankingSize > 0) {
+    for (const GuessScore& score : best) {
+      lastRanking.push_back(toRanked(score));
+    }
+  }
+  maxEntropy = best.empty() ? -1.0 : best.front().entropy;
+  return best.empty() ? -1 : best.front().guess;
+}
+
+WordleSolver::RankedGuess WordleSolver::toRanked(const GuessScore& score) const {
+  return {allWords->wordAt(score.guess), score.entropy, score.expectedRemaining, score.worstBucket};
+}
+
+std::vector<WordleSolver::RankedGuess> WordleSolver::rankGuesses(std::size_t k) const {
+  const std::vector<int>& guesses = hardMode ? legalGuesses : possibleWords;
+  std::vector<RankedGuess> ranking;
+  for (const GuessScore& score : topGuesses(guesses, k)) {
+    ranking.push_back(toRanked(score));
   }
+  return ranking;
+}
 
+/**
+ * @brief Cheap first pass: scores every guess by how evenly its letters split the possible words.
+ *
+ * With f = number of candidates containing a letter (or having it at a position), a letter
+ * contributes f * (n - f) / n, which is largest when it splits the candidates in half.
+ * Repeated letters only count once for the letter part. The top K are kept in a bounded
+ * min-heap; K starts at baseK and widens up to maxK while scores stay within tolerance.
+ *
+ * @param guesses Indices of the guesses to score.
+ * @return The shortlist, in dictionary order.
+ */
+std::vector<int> WordleSolver::prefilterGuesses(const std::vector<int>& guesses) const {
+  // Same kind of counts as getLetterFrequency, over the whole candidate set
+  std::array<int, 26> letterFrequency{};
+  std::array<std::array<int, 26>, 5> positionFrequency{};
+  for (const int word : possibleWords) {
+    const Word w = (*allWords)[word];
+    for (int i = 0; i < 5; ++i) {
+      positionFrequency[i][w.letterAt(i)]++;
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+      letterFrequency[letter] += w.contains(letter) ? 1 : 0;
+    }
+  }
+
+  const double n = static_cast<double>(possibleWords.size());
+  auto split = [n](int f) { return f * (n - f) / n; };
+
+  using Scored = std::pair<double, int>;
+  // Used as heap "less": the front of the heap is the worst kept guess
+  auto better = [](const Scored& a, const Scored& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  };
+  std::vector<Scored> heap;
+  const std::size_t maxK = std::max(prefilter.maxK, prefilter.baseK);
+  heap.reserve(maxK + 1);
+
+  for (const int guess : guesses) {
+    const Word g = (*allWords)[guess];
+    double score = 0.0;
+    for (int i = 0; i < 5; ++i) {
+      score += split(positionFrequency[i][g.letterAt(i)]);
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+      if (g.contains(letter)) score += split(letterFrequency[letter]);
+    }
+
+    if (heap.size() < maxK) {
+      heap.emplace_back(score, guess);
+      std::push_heap(heap.begin(), heap.end(), better);
+    } else if (better({score, guess}, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), better);
+      heap.back() = {score, guess};
+      std::push_heap(heap.begin(), heap.end(), better);
+    }
+  }
 
-  for (const auto& [word, entropy] : entropyMap) {
-    if(entropy > maxEntropy) {
-      maxEntropy = entropy;
-      nextGuess = word;
+  // Best first, then widen K past baseK only while the scores are close to the cutoff
+  std::sort_heap(heap.begin(), heap.end(), better);
+  std::size_t k = std::min(prefilter.baseK, heap.size());
+  if (k > 0) {
+    const double cutoff = heap[k - 1].first * (1.0 - prefilter.tolerance);
+    while (k < heap.size() && heap[k].first >= cutoff) {
+      k++;
     }
   }
 
+  std::vector<int> shortlist;
+  shortlist.reserve(k);
+  for (std::size_t i = 0; i < k; ++i) {
+    shortlist.push_back(heap[i].second);
+  }
+  std::sort(shortlist.begin(), shortlist.end());
+  return shortlist;
+}
+
+/**
+ * @brief Anytime version of nextGuess() that respects a latency budget.
+ *
+ * Small candidate sets are scored exactly. Larger ones are first scored on a stratified
+ * random sample of the candidates, then the leading guesses are re-scored exactly while
+ * time remains. When the deadline hits, the best guess found so far is returned.
+ * The probe word heuristic is applied afterwards just like in nextGuess().
+ *
+ * @param options Time budget, sample size, refine count and seed.
+ * @throws NoValidGuessesLeftException if there are no possible words left to guess.
+ * @return The guess together with its (estimated) entropy and how it was obtained.
+ */
+WordleSolver::GuessResult WordleSolver::nextGuess(const AnytimeOptions& options) {
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now() + options.budget;
+
+  if(game->getTries() >= game->getMaxTries()) {
+    throw NoValidGuessesLeftException();
+  }
+
+  GuessResult result;
+  if (tries == 0) {
+    tries++;
+    result.word = "slate";
+    const int opener = allWords->indexOf(result.word);
+    if (opener != -1) {
+      result.entropy = calculateEntropy(opener, possibleWords);
+      result.exact = true;
+      result.evaluated = 1;
+    }
+    return result;
+  }
+
+  int nextGuess = -1;
+  double maxEntropy = -1.0;
+  const std::vector<int>& guesses = hardMode ? legalGuesses : possibleWords;
+
+  const bool sampled = possibleWords.size() > options.sampleSize;
+  if (!sampled) {
+    // Cheap enough to score exactly; only the deadline can cut it short
+    for (std::size_t i = 0; i < guesses.size(); ++i) {
+      if (i > 0 && i % 16 == 0 && Clock::now() >= deadline) {
+        result.deadlineHit = true;
+        break;
+      }
+      const double entropy = calculateEntropy(guesses[i], possibleWords);
+      result.evaluated++;
+      if (entropy > maxEntropy) {
+        maxEntropy = entropy;
+        nextGuess = guesses[i];
+      }
+    }
+    // Exact only if no legal guess was skipped, otherwise the best one may be among the rest
+    result.exact = !result.deadlineHit;
+  } else {
+    // Stage 1: estimate every guess on the same sample
+    const auto sample = sampleCandidates(options.sampleSize, options.seed + static_cast<std::uint64_t>(tries));
+    struct Estimate {
+      int word;
+      double entropy;
+      double standardError;
+    };
+    std::vector<Estimate> estimates;
+    estimates.reserve(guesses.size());
+    for (std::size_t i = 0; i < guesses.size(); ++i) {
+      if (i > 0 && i % 16 == 0 && Clock::now() >= deadline) {
+        result.deadlineHit = true;
+        break;
+      }
+      double standardError = 0.0;
+      const double entropy = estimateEntropy(guesses[i], sample, standardError);
+      estimates.push_back({guesses[i], entropy, standardError});
+    }
+    result.evaluated = estimates.size();
+
+    // Stage 2: refine the leading estimates exactly, best estimate first
+    const std::size_t leading = std::min(options.refineCount, estimates.size());
+    std::partial_sort(estimates.begin(), estimates.begin() + static_cast<std::ptrdiff_t>(leading), estimates.end(),
+                      [](const Estimate& a, const Estimate& b) {
+                        return a.entropy > b.entropy || (a.entropy == b.entropy && a.word < b.word);
+                      });
+    for (std::size_t i = 0; i < leading; ++i) {
+      if (Clock::now() >= deadline) {
+        result.deadlineHit = true;
+        break;
+      }
+      const double entropy = calculateEntropy(estimates[i].word, possibleWords);
+      result.refined++;
+      if (entropy > maxEntropy) {
+        maxEntropy = entropy;
+        nextGuess = estimates[i].word;
+      }
+    }
+
+    if (result.refined > 0) {
+      result.exact = true;
+    } else {
+      nextGuess = estimates.front().word;
+      maxEntropy = estimates.front().entropy;
+      result.standardError = estimates.front().standardError;
+    }
+  }
+
+  const int probe = applyProbeWord(nextGuess);
+  if (probe != nextGuess) {
+    nextGuess = probe;
+    maxEntropy = calculateEntropy(nextGuess, possibleWords);
+    if (sampled) result.exact = true; // exact path: keeps whether every guess was scored
+    result.standardError = 0.0;
+  }
+
+  tries++;
+  result.word = allWords->wordAt(nextGuess);
+  result.entropy = maxEntropy;
+  return result;
+}
+
+/**
+ * @brief Draws a stratified random sample of the possible words.
+ * Strata are the first letters; every non-empty stratum gets a share proportional to
+ * its size (at least one word), drawn without replacement.
+ * @param sampleSize Wanted number of sampled words (approximately).
+ * @param seed Seed of the random generator.
+ * @return The sampled words, each weighted with the number of candidates it represents.
+ */
+std::vector<WordleSolver::SampledWord> WordleSolver::sampleCandidates(std::size_t sampleSize, std::uint64_t seed) const {
+  std::array<std::vector<int>, 26> strata;
+  for (const int word : possibleWords) {
+    strata[(*allWords)[word].letterAt(0)].push_back(word);
+  }
+
+  std::mt19937_64 gen(seed);
+  std::vector<SampledWord> sample;
+  sample.reserve(sampleSize + strata.size());
+  const double total = static_cast<double>(possibleWords.size());
+
+  for (auto& stratum : strata) {
+    if (stratum.empty()) continue;
+    std::size_t quota = static_cast<std::size_t>(std::lround(sampleSize * (stratum.size() / total)));
+    quota = std::min(std::max<std::size_t>(quota, 1), stratum.size());
+    // Partial Fisher-Yates: the first quota entries become the sample
+    for (std::size_t i = 0; i < quota; ++i) {
+      std::uniform_int_distribution<std::size_t> dis(i, stratum.size() - 1);
+      std::swap(stratum[i], stratum[dis(gen)]);
+      sample.push_back({stratum[i], static_cast<double>(stratum.size()) / quota});
+    }
+  }
+  return sample;
+}
+
+/**
+ * @brief Estimates the entropy of a guess from a weighted sample of the possible words.
+ * @param guess Index of the guess word.
+ * @param sample Weighted sample from sampleCandidates.
+ * @param standardError Receives the (delta method) standard error of the estimate.
+ * @return The estimated entropy.
+ */
+double WordleSolver::estimateEntropy(int guess, const std::vector<SampledWord>& sample, double& standardError) const {
+  standardError = 0.0;
+  if (sample.empty()) return 0.0;
+
+  std::array<double, PATTERN_COUNT> patternWeight{};
+  double total = 0.0;
+  const Word guessWord = (*allWords)[guess];
+  for (const auto& [word, weight] : sample) {
+    patternWeight[FeedbackStrategy::calculatePattern(guessWord, (*allWords)[word])] += weight;
+    total += weight;
+  }
+
+  double entropy = 0.0;
+  double secondMoment = 0.0;
+  for (const double weight : patternWeight) {
+    if (weight <= 0.0) continue;
+    const double p = weight / total;
+    const double information = std::log2(p);
+    entropy -= p * information;
+    secondMoment += p * information * information;
+  }
+  standardError = std::sqrt(std::max(0.0, secondMoment - entropy * entropy) / static_cast<double>(sample.size()));
+  return entropy;
+}
+
+/**
+ * @brief Replaces the entropy guess with a probe word if the pattern is restricting
+ * (4 correct slots, or 3 correct slots with repeating feedback).
+ * @param nextGuess Index of the guess chosen by entropy.
+ * @return Index of the guess to play.
+ */
+int WordleSolver::applyProbeWord(int nextGuess) {
   int CorrectCount = 0;
   bool repeating = false;
+  const auto lastFeedback = FeedbackStrategy::decodePattern(getStoredFeedback(tries - 1));
 
-  for (Feedback fbk : getStoredFeedback(tries - 1) ) {
+  for (Feedback fbk : lastFeedback) {
     if (fbk == Feedback::Correct) {
       CorrectCount++;
     }
@@ -167,7 +608,7 @@ std::string WordleSolver::nextGuess() {
 
     std::array<int, 26> probeLetterFrequency{};
     for (int i = 0; i < possibleWords.size(); i++) {
-      std::array<int, 26> tempFreq = getLetterFrequency(possibleWords[i], getStoredFeedback(tries -1), Feedback::Absent);
+      std::array<int, 26> tempFreq = getLetterFrequency((*allWords)[possibleWords[i]], lastFeedback, Feedback::Absent);
       for (int j = 0; j < 26; j++) {
         probeLetterFrequency[j] = probeLetterFrequency[j] + tempFreq[j];
       }
@@ -184,56 +625,44 @@ std::string WordleSolver::nextGuess() {
 
 
     ProbeInfo probe = findProbeWord(probeLetterFrequency, CorrectCount);
-    if (CorrectCount == 4 && probe.coverage >= 2 || CorrectCount == 3 && probe.coverage >= 3) {
+    if (probe.word != -1 && (CorrectCount == 4 && probe.coverage >= 2 || CorrectCount == 3 && probe.coverage >= 3)) {
       nextGuess = probe.word;
     }
   }
 
-  // Possible Improvements:
-  /* Letter frequency top entropy sorting (WIP)
-  if (possibleWords.size() <= 20 && possibleWords.size() > 2 && tries < 4 && maxEntropy <= ENTROPY_THRESHOLD) {
-    // std::cout << "[DEBUG] maxEntropy: "<< maxEntropy << '\n';
-    for (const auto& [word, entropy] : entropyMap) {
-      if (entropy  >= maxEntropy-(maxEntropy * 0.80 )) {
-        topGuesses.push_back(word);
-        // std::cout << "[DEBUG] top Word added: "<< word << '\n';
-      }
-    }
-  }
-  */
-
-
-  tries++;
   return nextGuess;
 }
 
-int WordleSolver::scoreProbe3Word(const std::string& word, const std::array<int, 26>& probeChars){
-  std::unordered_set<std::string> patterns;
-  std::string fdbk = feedbackToString(getStoredFeedback(tries -1));
+int WordleSolver::scoreProbe3Word(Word word, const std::array<int, 26>& probeChars) const {
+  static constexpr int POW3[5] = {1, 3, 9, 27, 81};
+  std::bitset<PATTERN_COUNT> patterns;
+  int fdbk[5];
 
-  for (const std::string& possible_word : possibleWords) {
+  for (const int possible : possibleWords) {
+    const Word possibleWord = (*allWords)[possible];
     for (int i = 0; i < 5; ++i) {
-      fdbk[i] = (word[i] == possible_word[i]) ? '2' : '0';
+      fdbk[i] = (word.letterAt(i) == possibleWord.letterAt(i)) ? 2 : 0;
     }
 
+    int code = 0;
     for (int i = 0; i < 5; ++i) {
-      if (fdbk[i] == '0') {
+      if (fdbk[i] == 0) {
         for (int j = 0; j < 5; ++j)
-          if (fdbk[j] != '2' && word[i] == possible_word[j])
-          { fdbk[i] = '1'; break; }
+          if (fdbk[j] != 2 && word.letterAt(i) == possibleWord.letterAt(j))
+          { fdbk[i] = 1; break; }
       }
+      code += fdbk[i] * POW3[i];
     }
-    patterns.insert(fdbk);
+    patterns.set(code);
   }
-  return static_cast<int>(patterns.size());
+  return static_cast<int>(patterns.count());
 }
 
-int WordleSolver::scoreProbe4Word(const std::string& word, const std::array<int, 26>& probeChars) {
+int WordleSolver::scoreProbe4Word(Word word, const std::array<int, 26>& probeChars) const {
   std::array<int,26> used{};
-  std::string fdbk = feedbackToString(getStoredFeedback(tries -1));
 
-  for (const char &ch : word) {
-    ++used[std::tolower(ch) - 'a'];
+  for (int i = 0; i < 5; ++i) {
+    ++used[word.letterAt(i)];
   }
 
   double score = 0;
@@ -254,11 +683,12 @@ WordleSolver::ProbeInfo WordleSolver::findProbeWord(const std::array<int, 26>& p
   WordleSolver::ProbeInfo bestProbe;
   int cover;
 
-  for (const std::string w : allWords) {
+  // In hard mode only legal words may be used as probes
+  for (const int w : allowedGuesses()) {
     if (correctAmount == 3) {
-      cover = scoreProbe3Word(w, probeChars);
+      cover = scoreProbe3Word((*allWords)[w], probeChars);
     }else {
-      cover = scoreProbe4Word(w, probeChars);
+      cover = scoreProbe4Word((*allWords)[w], probeChars);
     }
 
     if (cover > bestProbe.coverage) {
@@ -280,11 +710,31 @@ WordleSolver::ProbeInfo WordleSolver::findProbeWord(const std::array<int, 26>& p
  * @return True if the word matches the feedback pattern, false otherwise.
  */
 bool WordleSolver::matchesFeedback(const std::string& word, const std::string& guess, const std::vector<Feedback>& feedback) const {
+  if (feedback.size() != 5) {
+    throw std::runtime_error("Invalid feedback size!");
+  }
+  const Word packed = packWord(word);
+  std::array<Feedback, WORD_LENGTH> fdbk{};
+  std::copy(feedback.begin(), feedback.end(), fdbk.begin());
+  return matchesFeedback(packed, letterCountsOf(packed), packWord(guess), fdbk);
+}
+
+/**
+ * @brief Packed version of matchesFeedback, used for filtering.
+ * @param word The word to check.
+ * @param wordCounts The letter-count signature of word.
+ * @param guess The old guess to compare letters
+ * @param feedback The feedback pattern to match.
+ * @return True if the word matches the feedback pattern, false otherwise.
+ */
+bool WordleSolver::matchesFeedback(Word word, LetterCounts wordCounts, Word guess, const std::array<Feedback, WORD_LENGTH>& feedback) const {
   // 1) Filters out words which didn't match absent letters and the '=' feedback
+  if (word.mask & absentLetters) {
+    return false;
+  }
   for (int i = 0; i < 5; ++i) {
-    if ( (feedback[i] == Feedback::Correct  && word[i] != guess[i])   ||
-         (absentLetters.count(word[i]))                              ||
-         (feedback[i] == Feedback::Present && word[i] == guess[i]) ) {
+    if ( (feedback[i] == Feedback::Correct  && word.letterAt(i) != guess.letterAt(i))   ||
+         (feedback[i] == Feedback::Present && word.letterAt(i) == guess.letterAt(i)) ) {
       return false;
     }
   }
@@ -293,8 +743,9 @@ bool WordleSolver::matchesFeedback(const std::string& word, const std::string& g
   for (int i= 0; i < 26; i++) {
     int need = oldPresentLetters[i];
     if (need == 0) continue;
+    if (!word.contains(i)) return false;
     for (int j = 0; j < 5; j++) {
-      if (feedback[j] != Feedback::Correct && std::tolower(word[j]) == ('a' + i)) {
+      if (feedback[j] != Feedback::Correct && word.letterAt(j) == i) {
         need--;
       }
     }
@@ -311,13 +762,7 @@ bool WordleSolver::matchesFeedback(const std::string& word, const std::string& g
   // FIXES: [DEBUG] Word added: sassy -> now not possible because max(s) == 1
   for (int i = 0; i < 26; ++i) {
     int limit = maxLetters[i];       // -1 means “unlimited”
-    int count = 0;
-    for (const char &ch : word) {
-      if (ch - 'a' == i) {
-        count++;
-      }
-    }
-    if (limit != -1 && count > limit) {
+    if (limit != -1 && letterCount(wordCounts, i) > limit) {
       return false;
     }
   }
@@ -356,13 +801,23 @@ void WordleSolver::updatePossibleWords(const std::string& guess, const std::vect
 
   // Generate letterFrequency based on the old guess:
   // !!! DO NOT keep the present list for next guesses as it may get upgraded to = later so just redo every time you do a new guess
+  const Word guessWord = packWord(guess);
+  std::array<Feedback, WORD_LENGTH> fdbk{};
+  std::copy(feedback.begin(), feedback.end(), fdbk.begin());
+
   oldPresentLetters.fill(0);
-  oldPresentLetters = getLetterFrequency(guess, feedback, Feedback::Present);
+  oldPresentLetters = getLetterFrequency(guessWord, fdbk, Feedback::Present);
+  const Pattern pattern = FeedbackStrategy::toPattern(feedback);
+  constraints.push_back({guessWord, pattern});
+  if (hardMode) {
+    updateLegalGuesses(guessWord, pattern);
+  }
 
-  std::vector<std::string> filtered;
-  for (const std::string& word : possibleWords) {
-    if (word == guess) continue;
-    if (matchesFeedback(word, guess, feedback)) {
+  std::vector<int> filtered;
+  filtered.reserve(possibleWords.size());
+  for (const int word : possibleWords) {
+    if ((*allWords)[word] == guessWord) continue;
+    if (matchesFeedback((*allWords)[word], allWords->countsAt(word), guessWord, fdbk)) {
       filtered.push_back(word);
      // std::cout << "[DEBUG] Added possible Word: " << word << '\n' ;
     }
@@ -377,6 +832,54 @@ void WordleSolver::updatePossibleWords(const std::string& guess, const std::vect
 }
 
 
+/**
+ * @brief Switches hard mode. Turning it on rebuilds the legal guesses from the constraints so far,
+ * so normal-mode turns never pay for the narrowing.
+ */
+void WordleSolver::setHardMode(bool enabled) {
+  if (enabled && !hardMode) {
+    legalGuesses = allGuesses;
+    for (const auto& [guess, pattern] : constraints) {
+      updateLegalGuesses(guess, pattern);
+    }
+  }
+  hardMode = enabled;
+}
+
+/**
+ * @brief Narrows the hard-mode legal guesses by the constraints of one feedback.
+ * Greens must stay in place and every green/yellow letter must be reused at least as often.
+ * Both are intersections with the posting lists of the word table, no rescan of allWords.
+ * @param guess The guessed word.
+ * @param pattern The feedback for the guess.
+ */
+void WordleSolver::updateLegalGuesses(Word guess, Pattern pattern) {
+  const std::vector<Feedback> feedback = FeedbackStrategy::toFeedback(pattern);
+  std::array<int, 26> required{};
+  std::vector<int> narrowed;
+
+  auto intersect = [&](const std::vector<int>& postings) {
+    narrowed.clear();
+    std::set_intersection(legalGuesses.begin(), legalGuesses.end(), postings.begin(), postings.end(),
+                          std::back_inserter(narrowed));
+    legalGuesses = std::move(narrowed);
+  };
+
+  for (int i = 0; i < 5; ++i) {
+    if (feedback[i] == Feedback::Absent) continue;
+    required[guess.letterAt(i)]++;
+    if (feedback[i] == Feedback::Correct) {
+      intersect(allWords->withLetterAt(i, guess.letterAt(i)));
+    }
+  }
+  for (int letter = 0; letter < 26; ++letter) {
+    if (required[letter] > 0) {
+      // Counts saturate at 3, like the letter-count signature
+      intersect(allWords->withLetterCount(letter, std::min(required[letter], 3)));
+    }
+  }
+}
+
 /**
  * @brief Adds letters to the absentLetters set based on the guess and feedback.
  *        Letters are added only if they are marked as Absent and not present elsewhere as Correct or Present.
@@ -392,23 +895,23 @@ void WordleSolver::addAbsentLetters(const std::string& guess, const std::vector<
     throw std::runtime_error("Invalid feedback size!");
   }
 
+  const Word guessWord = packWord(guess);
   for (int i = 0; i < 5; i++) {
     // could call WordleSolver::feedbackToString but who cares?
     if (feedback[i] == Feedback::Absent) {
-      char c = std::tolower(guess[i]);
+      const int c = guessWord.letterAt(i);
       bool seen_elsewhere = false;
       for (int j = 0; j < 5; ++j) {
-        if (j != i && std::tolower(guess[j]) == c && (feedback[j] == Feedback::Correct || feedback[j] == Feedback::Present)) {
+        if (j != i && guessWord.letterAt(j) == c && (feedback[j] == Feedback::Correct || feedback[j] == Feedback::Present)) {
           seen_elsewhere = true;
           break;
         }
       }
-      // IF there is 1.) a unique absent letter 2.) not in the list -> add it
-      if (!seen_elsewhere && !absentLetters.count(c)) {
-        absentLetters.insert(c);
+      // IF there is 1.) a unique absent letter 2.) not in the mask -> add it
+      if (!seen_elsewhere) {
+        absentLetters |= 1u << c;
         // std::cout << "[DEBUG] New absent Letter: " << c << '\n';
       }
-      // std::cout << "[DEBUG] Amount of absent Letter "<< guess[i] << " already inside: " << absentLetters.count(guess[i]) << '\n';
     }
   }
 }
@@ -417,20 +920,28 @@ void WordleSolver::addAbsentLetters(const std::string& guess, const std::vector<
 
 // Improved functionality of addAbsentLetters, because simply showing the if a letter is 100% missing or dont know is bad
 void WordleSolver::updateMaxLetters(const std::string& guess, const std::vector<Feedback>& feedback) {
-  std::string tempWord = guess;
+  if (feedback.size() != 5) {
+    throw std::runtime_error("Invalid feedback size!");
+  }
+  const Word guessWord = packWord(guess);
+  std::array<int, 5> tempWord{};
+  for (int i = 0; i < 5; i++) {
+    tempWord[i] = guessWord.letterAt(i);
+  }
   for (int i = 0; i < 5; i++) {
     if (feedback[i] != Feedback::Absent) continue;
+    const int letter = guessWord.letterAt(i);
     int count = 0;
     for (int j = 0; j < 5; j++) {
-      if (tempWord[j] != guess[i]) continue;
+      if (tempWord[j] != letter) continue;
       if (feedback[j] == Feedback::Absent) {
-        tempWord[j] = '_';
+        tempWord[j] = -1;
       } else {
         count++;
       }
     }
-    if (maxLetters[guess[i] - 'a'] == -1) {
-      maxLetters[guess[i] - 'a'] = count;
+    if (maxLetters[letter] == -1) {
+      maxLetters[letter] = count;
     }
   }
   // std::cout << "Max letter(n): "<< maxLetters[13] << '\n';
@@ -447,41 +958,20 @@ void WordleSolver::updateMaxLetters(const std::string& guess, const std::vector<
  * @return A vector of Feedback enums representing the feedback pattern.
  */
 std::vector<Feedback> WordleSolver::feedbackPattern(const std::string& guess, const std::string& solution) const {
-  // No neutral element so I choose Absent as it might cause less issues, if there are mistakes down the code
-  std::vector<Feedback> feedback = {Feedback::Absent, Feedback::Absent, Feedback::Absent ,Feedback::Absent , Feedback::Absent};
-  std::vector<char> solutionChar = {solution[0], solution[1], solution[2], solution[3], solution[4]};
-
-  if (guess.size() != 5 || solution.size() != 5) {
-    throw NotAFiveLetterWordException(guess);
-  }
-
-  // Check for correctly placed chars and remove those from the solution String
-  for (int i = 0; i < 5; i++) {
-    if (std::tolower(solution[i]) == std::tolower(guess[i]) ) {
-      feedback[i] = Feedback::Correct;
-      // Needs to replace letter so that it can't get flag it as "Present" later on
-      solutionChar[i] = '_';
-    }
-  }
+  // Strings only live at the I/O boundary: pack once, then compare in registers
+  return FeedbackStrategy::toFeedback(m_feedbackStrategy->calculatePattern(packWord(guess), packWord(solution)));
+}
 
-  // Check how many misspositioned letters there are
-  for (int i = 0; i < 5; i++) {
-    for (int j = 0; j < 5; j++) {
-      if (feedback[i] == Feedback::Correct) {
-        break;
-      }
-      if (std::tolower(guess[i]) == std::tolower(solutionChar[j])) {
-        feedback[i] = Feedback::Present;
-        // remove this char (_) so that
-        // Solution: "steal" -> Guess: "speed" -> will only set give one "1" for your e instead of "1" for each e
-        solutionChar[j] = '_';
-        break;
-      }
-    }
+/**
+ * @brief Returns the remaining possible solutions as strings (I/O boundary).
+ */
+std::vector<std::string> WordleSolver::getPossibleWords() const {
+  std::vector<std::string> words;
+  words.reserve(possibleWords.size());
+  for (const int word : possibleWords) {
+    words.push_back(allWords->wordAt(word));
   }
-
-
-  return feedback;
+  return words;
 }
 
 /**
@@ -510,18 +1000,20 @@ void WordleSolver::printGuessingInfo() const {
 
 /**
  * @brief Prints the entropy results for the remaining possible words.
- * @param entropyResults A vector of pairs containing words and their corresponding entropy values.
+ * @param entropyResults Ranked guesses as returned by rankGuesses, best first.
  */
-void WordleSolver::printEntropyResults(const std::vector<std::pair<std::string, double>>& entropyResults) {
+void WordleSolver::printEntropyResults(const std::vector<RankedGuess>& entropyResults) {
   std::cout << "[INFO] Entropy results for remaining possible words (sorted):" << std::endl;
-  for (const auto& [word, entropy] : entropyResults) {
+  for (const auto& result : entropyResults) {
     std::ostringstream oss;
-    oss << "  Entropy for \"" << word << "\": ";
-    if (entropy < 0.01 && entropy > 0.0) {
-      oss << std::scientific << entropy << " bits";
+    oss << "  Entropy for \"" << result.word << "\": ";
+    if (result.entropy < 0.01 && result.entropy > 0.0) {
+      oss << std::scientific << result.entropy << " bits";
     } else {
-      oss << std::fixed << entropy << " bits";
+      oss << std::fixed << result.entropy << " bits";
     }
+    oss << std::fixed << std::setprecision(1) << ", expected remaining: " << result.expectedRemaining
+        << ", worst case: " << result.worstBucket;
     std::cout << oss.str() << std::endl;
   }
 }